@@ -0,0 +1,98 @@
+#include "BoardRenderer.hpp"
+#include <cmath>
+
+namespace {
+    const int DiscSegments = 24;
+    const float HintRadius = 15.f;
+    const float PieceScale = 0.75f;
+    const sf::Color HighlightColor(255, 215, 0, 140);
+
+    sf::Vector2f cellOrigin(int square) {
+        return sf::Vector2f(fileOf(square) * BoardRenderer::SquareSize, (7 - rankOf(square)) * BoardRenderer::SquareSize);
+    }
+}
+
+BoardRenderer::BoardRenderer(const PieceAtlas& atlas) : atlas(atlas), vertices(sf::Triangles) {}
+
+void BoardRenderer::update(const Position& position, const std::vector<sf::Vector2i>& moveHints,
+                           const std::vector<sf::Vector2i>& captureHints, sf::Vector2i highlight,
+                           const MoveAnimation* animation) {
+    vertices.clear();
+    sf::FloatRect white = atlas.getWhiteRect();
+
+    for (int y = 0; y < 8; ++y) {
+        for (int x = 0; x < 8; ++x) {
+            sf::Color color = ((x + y) % 2 == 0) ? sf::Color::White : sf::Color::Black;
+            addQuad(sf::FloatRect(x * SquareSize, y * SquareSize, SquareSize, SquareSize), white, color);
+        }
+    }
+
+    if (highlight.x >= 0 && highlight.y >= 0) {
+        addQuad(sf::FloatRect(highlight.x * SquareSize, highlight.y * SquareSize, SquareSize, SquareSize), white, HighlightColor);
+    }
+
+    Bitboard occupied = position.occupied();
+    if (animation) {
+        occupied &= ~squareBB(animation->to);
+    }
+    while (occupied) {
+        int square = popLsb(occupied);
+        addPiece(position, square, cellOrigin(square));
+    }
+    // The moving piece goes last so it slides over everything else.
+    if (animation) {
+        sf::Vector2f start = cellOrigin(animation->from);
+        sf::Vector2f end = cellOrigin(animation->to);
+        addPiece(position, animation->to, start + (end - start) * animation->progress);
+    }
+
+    for (const auto& hint : moveHints) {
+        addDisc(sf::Vector2f(hint.x * SquareSize + SquareSize / 2, hint.y * SquareSize + SquareSize / 2), HintRadius, sf::Color::Green);
+    }
+    for (const auto& hint : captureHints) {
+        addDisc(sf::Vector2f(hint.x * SquareSize + SquareSize / 2, hint.y * SquareSize + SquareSize / 2), HintRadius, sf::Color::Red);
+    }
+}
+
+void BoardRenderer::addPiece(const Position& position, int square, sf::Vector2f topLeft) {
+    float pieceSize = PieceAtlas::CellSize * PieceScale;
+    float margin = (SquareSize - pieceSize) / 2;
+    sf::IntRect rect = atlas.getRect(position.colorOn(square), position.pieceTypeOn(square));
+    addQuad(sf::FloatRect(topLeft.x + margin, topLeft.y + margin, pieceSize, pieceSize), sf::FloatRect(rect), sf::Color::White);
+}
+
+void BoardRenderer::addQuad(sf::FloatRect area, sf::FloatRect texCoords, sf::Color color) {
+    sf::Vector2f topLeft(area.left, area.top);
+    sf::Vector2f topRight(area.left + area.width, area.top);
+    sf::Vector2f bottomRight(area.left + area.width, area.top + area.height);
+    sf::Vector2f bottomLeft(area.left, area.top + area.height);
+    sf::Vector2f texTopLeft(texCoords.left, texCoords.top);
+    sf::Vector2f texTopRight(texCoords.left + texCoords.width, texCoords.top);
+    sf::Vector2f texBottomRight(texCoords.left + texCoords.width, texCoords.top + texCoords.height);
+    sf::Vector2f texBottomLeft(texCoords.left, texCoords.top + texCoords.height);
+
+    vertices.append(sf::Vertex(topLeft, color, texTopLeft));
+    vertices.append(sf::Vertex(topRight, color, texTopRight));
+    vertices.append(sf::Vertex(bottomRight, color, texBottomRight));
+    vertices.append(sf::Vertex(topLeft, color, texTopLeft));
+    vertices.append(sf::Vertex(bottomRight, color, texBottomRight));
+    vertices.append(sf::Vertex(bottomLeft, color, texBottomLeft));
+}
+
+void BoardRenderer::addDisc(sf::Vector2f center, float radius, sf::Color color) {
+    sf::FloatRect white = atlas.getWhiteRect();
+    sf::Vector2f texCoord(white.left + white.width / 2, white.top + white.height / 2);
+    const float step = 2 * 3.14159265f / DiscSegments;
+    for (int i = 0; i < DiscSegments; ++i) {
+        sf::Vector2f a(center.x + radius * std::cos(i * step), center.y + radius * std::sin(i * step));
+        sf::Vector2f b(center.x + radius * std::cos((i + 1) * step), center.y + radius * std::sin((i + 1) * step));
+        vertices.append(sf::Vertex(center, color, texCoord));
+        vertices.append(sf::Vertex(a, color, texCoord));
+        vertices.append(sf::Vertex(b, color, texCoord));
+    }
+}
+
+void BoardRenderer::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    states.texture = &atlas.getTexture();
+    target.draw(vertices, states);
+}
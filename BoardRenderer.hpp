@@ -0,0 +1,40 @@
+#ifndef BOARDRENDERER_HPP
+#define BOARDRENDERER_HPP
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "PieceAtlas.hpp"
+#include "Position.hpp"
+
+// Builds the squares, pieces and move hints of one board into a single
+// vertex array textured by the piece atlas, so the whole board is one draw
+// call. Apply a transform through sf::RenderStates to place several boards
+// in one window.
+class BoardRenderer : public sf::Drawable {
+public:
+    static constexpr float SquareSize = 100.f;
+
+    // A piece sliding from `from` to `to`; the position already has it on `to`.
+    struct MoveAnimation {
+        int from;
+        int to;
+        float progress; // 0 on the start square, 1 on arrival
+    };
+
+    explicit BoardRenderer(const PieceAtlas& atlas);
+    // `highlight` is a cell to tint, or (-1, -1) for none. `animation` may be null.
+    void update(const Position& position, const std::vector<sf::Vector2i>& moveHints,
+                const std::vector<sf::Vector2i>& captureHints, sf::Vector2i highlight,
+                const MoveAnimation* animation);
+
+private:
+    const PieceAtlas& atlas;
+    sf::VertexArray vertices;
+
+    void addQuad(sf::FloatRect area, sf::FloatRect texCoords, sf::Color color);
+    void addPiece(const Position& position, int square, sf::Vector2f topLeft);
+    void addDisc(sf::Vector2f center, float radius, sf::Color color);
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+};
+
+#endif // BOARDRENDERER_HPP
@@ -1,13 +1,36 @@
 #include <SFML/Graphics.hpp>
 #include "ChessBoard.hpp"
 
+namespace {
+    // Caps frames while something animates; 0 means no cap. When nothing
+    // changes the loop sleeps in waitEvent and draws no frames at all.
+    const unsigned int FrameRateLimit = 60;
+    // While the engine thinks the loop polls for its reply at this rate,
+    // which bounds input latency to one frame.
+    const sf::Time PollInterval = sf::milliseconds(1000 / 60);
+}
+
 int main() {
+    Bitboards::init();
+
     sf::RenderWindow window(sf::VideoMode(800, 800), "Chess Game");
+    window.setFramerateLimit(FrameRateLimit);
 
     ChessBoard board;
 
     while (window.isOpen()) {
+        board.update();
+
         sf::Event event;
+        if (!board.needsRedraw() && !board.isThinking()) {
+            if (!window.waitEvent(event)) {
+                break;
+            }
+            if (event.type == sf::Event::Closed)
+                window.close();
+
+            board.handleEvent(event);
+        }
         while (window.pollEvent(event)) {
             if (event.type == sf::Event::Closed)
                 window.close();
@@ -15,9 +38,14 @@ int main() {
             board.handleEvent(event);
         }
 
-        window.clear();
-        board.draw(window);
-        window.display();
+        if (window.isOpen() && board.needsRedraw()) {
+            window.clear();
+            board.draw(window);
+            window.display();
+        }
+        else if (board.isThinking()) {
+            sf::sleep(PollInterval);
+        }
     }
 
     return 0;
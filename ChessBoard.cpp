@@ -1,276 +1,272 @@
 #include "ChessBoard.hpp"
 #include <iostream>
+#include <algorithm>
+#include <thread>
+#include "MoveGen.hpp"
 #include <SFML/Window.hpp>
 
-ChessBoard::ChessBoard() {
+namespace {
+    const float AnimationSeconds = 0.15f;
+    const int ComputerMoveMs = 1000;
+}
+
+ChessBoard::ChessBoard()
+    : renderer(atlas), hoveredCell(-1, -1), animating(false),
+      engine(static_cast<int>(std::thread::hardware_concurrency())), pendingSearch(0),
+      vsComputer(false), computerColor(Color::Black) {
     initBoard();
     pieceSelected = false;
-    currentTurn = Piece::Color::White;
-
 }
 
 ChessBoard::~ChessBoard() {
-    for (auto& row : board) {
-        for (auto& piece : row) {
-            delete piece;
-        }
-    }
 }
 
 void ChessBoard::initBoard() {
-    //  
-    for (auto& row : board) {
-        for (auto& piece : row) {
-            delete piece;
-            piece = nullptr;
+    position.setStartPosition();
+    pieceSelected = false;
+    moveHints.clear();
+    captureHints.clear();
+    animating = false;
+    dirty = true;
+    engine.newGame();
+    pendingSearch = 0;
+}
+
+void ChessBoard::draw(sf::RenderWindow& window) {
+    const BoardRenderer::MoveAnimation* activeAnimation = nullptr;
+    if (animating) {
+        animation.progress = animationClock.getElapsedTime().asSeconds() / AnimationSeconds;
+        if (animation.progress >= 1.f) {
+            animating = false;
+        }
+        else {
+            activeAnimation = &animation;
         }
     }
 
-    board.clear();
-    board.resize(8, std::vector<Piece*>(8, nullptr));
+    // Only a hovered hint square is tinted, to show where a click would move.
+    sf::Vector2i highlight(-1, -1);
+    if (pieceSelected && (std::find(moveHints.begin(), moveHints.end(), hoveredCell) != moveHints.end() ||
+        std::find(captureHints.begin(), captureHints.end(), hoveredCell) != captureHints.end())) {
+        highlight = hoveredCell;
+    }
+
+    renderer.update(position, moveHints, captureHints, highlight, activeAnimation);
+    window.draw(renderer);
+    dirty = false;
+}
 
-    for (int i = 0; i < 8; ++i) {
-        board[1][i] = new Pawn(Piece::Color::Black);
-        board[6][i] = new Pawn(Piece::Color::White);
+bool ChessBoard::needsRedraw() const {
+    return dirty || animating;
+}
+
+bool ChessBoard::isAnimating() const {
+    return animating;
+}
+
+void ChessBoard::startAnimation(int from, int to) {
+    animation.from = from;
+    animation.to = to;
+    animation.progress = 0.f;
+    animationClock.restart();
+    animating = true;
+}
+
+bool ChessBoard::isComputerTurn() const {
+    return vsComputer && position.sideToMove() == computerColor;
+}
+
+void ChessBoard::toggleComputer() {
+    vsComputer = !vsComputer;
+    // The computer takes over the side that is not about to move, so the
+    // player keeps the move they were about to make.
+    computerColor = opposite(position.sideToMove());
+    if (!vsComputer && pendingSearch) {
+        engine.stop();
+        pendingSearch = 0;
     }
+    std::cout << "Play vs computer: " << (vsComputer ? "on" : "off") << "\n";
+}
 
-    board[0][0] = new Rook(Piece::Color::Black);
-    board[0][7] = new Rook(Piece::Color::Black);
-    board[7][0] = new Rook(Piece::Color::White);
-    board[7][7] = new Rook(Piece::Color::White);
+bool ChessBoard::isThinking() const {
+    return pendingSearch != 0;
+}
 
-    board[0][1] = new Knight(Piece::Color::Black);
-    board[0][6] = new Knight(Piece::Color::Black);
-    board[7][1] = new Knight(Piece::Color::White);
-    board[7][6] = new Knight(Piece::Color::White);
+void ChessBoard::update() {
+    if (isComputerTurn() && !pendingSearch) {
+        MoveList legalMoves;
+        generateLegalMoves(position, legalMoves);
+        if (!legalMoves.empty()) {
+            SearchLimits limits;
+            limits.moveTimeMs = ComputerMoveMs;
+            engine.setPosition(position);
+            pendingSearch = engine.go(limits);
+        }
+    }
+
+    // Results wait in the queue until the last move has finished sliding.
+    EngineThread::Result result;
+    while (!animating && engine.pollResult(result)) {
+        if (result.searchId != pendingSearch || result.type != EngineThread::Result::BestMove) {
+            continue;
+        }
+        pendingSearch = 0;
+        const SearchInfo& info = result.info;
+        if (!info.hasMove || !isComputerTurn()) {
+            break;
+        }
+        std::cout << "Computer plays " << toUci(info.bestMove) << ": depth " << info.depth
+                  << ", score " << info.score << ", " << info.nodes << " nodes, "
+                  << info.timeMs << " ms, " << info.nps << " nps\n";
+        playMove(info.bestMove);
+    }
+}
 
-    board[0][2] = new Bishop(Piece::Color::Black);
-    board[0][5] = new Bishop(Piece::Color::Black);
-    board[7][2] = new Bishop(Piece::Color::White);
-    board[7][5] = new Bishop(Piece::Color::White);
+void ChessBoard::playMove(const Move& move) {
+    position.makeMove(move);
+    if (position.gamePly() + MaxPly >= Position::MaxGamePly) {
+        position.trimHistory();
+    }
+    startAnimation(move.from(), move.to());
 
-    board[0][3] = new Queen(Piece::Color::Black);
-    board[7][3] = new Queen(Piece::Color::White);
+    pieceSelected = false;
+    moveHints.clear();
+    captureHints.clear();
+    dirty = true;
 
-    board[0][4] = new King(Piece::Color::Black);
-    board[7][4] = new King(Piece::Color::White);
+    if (isCheckmate(Color::White)) {
+        handleCheckmate(Color::Black);
+    }
+    else if (isCheckmate(Color::Black)) {
+        handleCheckmate(Color::White);
+    }
 }
 
-void ChessBoard::draw(sf::RenderWindow& window) {
-    drawBoard(window);
-    drawPieces(window);
-    if (pieceSelected) {
-        drawHints(window);
+void ChessBoard::handleMouseMove(int mouseX, int mouseY) {
+    sf::Vector2i cell(mouseX / 100, mouseY / 100);
+    if (mouseX < 0 || mouseY < 0 || cell.x > 7 || cell.y > 7) {
+        cell = sf::Vector2i(-1, -1);
+    }
+    if (cell != hoveredCell) {
+        hoveredCell = cell;
+        if (pieceSelected) {
+            dirty = true;
+        }
     }
 }
 
 void ChessBoard::handleEvent(const sf::Event& event) {
-    static Piece::Color currentPlayer = Piece::Color::White;
+    if (event.type == sf::Event::Resized || event.type == sf::Event::GainedFocus) {
+        dirty = true;
+    }
+    else if (event.type == sf::Event::MouseMoved) {
+        handleMouseMove(event.mouseMove.x, event.mouseMove.y);
+    }
+    else if (event.type == sf::Event::MouseLeft) {
+        handleMouseMove(-1, -1);
+    }
+    else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::C) {
+        toggleComputer();
+    }
 
     if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
         int x = event.mouseButton.x / 100;
         int y = event.mouseButton.y / 100;
+        if (x < 0 || x > 7 || y < 0 || y > 7 || isComputerTurn()) {
+            return;
+        }
         if (pieceSelected) {
             auto validMoves = getValidMoves(selectedPiece.x, selectedPiece.y);
-            validMoves.erase(std::remove_if(validMoves.begin(), validMoves.end(), [this](sf::Vector2i move) {
-                return !willMovePreventCheck(selectedPiece.x, selectedPiece.y, move.x, move.y, board[selectedPiece.y][selectedPiece.x]->getColor());
-                }), validMoves.end());
             sf::Vector2i target(x, y);
             if (std::find(validMoves.begin(), validMoves.end(), target) != validMoves.end()) {
-                if (dynamic_cast<King*>(board[selectedPiece.y][selectedPiece.x])) {
-                    if (target.x == selectedPiece.x - 2) { 
-                        std::swap(board[selectedPiece.y][selectedPiece.x], board[target.y][target.x]);
-                        std::swap(board[target.y][0], board[target.y][target.x + 1]);
-                        dynamic_cast<King*>(board[target.y][target.x])->hasMoved = true;
-                        dynamic_cast<Rook*>(board[target.y][target.x + 1])->hasMoved = true;
-                    }
-                    else if (target.x == selectedPiece.x + 2) {
-                        std::swap(board[selectedPiece.y][selectedPiece.x], board[target.y][target.x]);
-                        std::swap(board[target.y][7], board[target.y][target.x - 1]);
-                        dynamic_cast<King*>(board[target.y][target.x])->hasMoved = true;
-                        dynamic_cast<Rook*>(board[target.y][target.x - 1])->hasMoved = true;
-                    }
-                    else { 
-                        if (board[target.y][target.x] != nullptr) {
-                            delete board[target.y][target.x]; 
-                        }
-                        board[target.y][target.x] = board[selectedPiece.y][selectedPiece.x];
-                        board[selectedPiece.y][selectedPiece.x] = nullptr;
-                        dynamic_cast<King*>(board[target.y][target.x])->hasMoved = true;
-                    }
-                }
-                else {
-                    if (board[y][x] != nullptr) {
-                        delete board[y][x];
-                        board[y][x] = nullptr;
-                    }
-                    std::swap(board[selectedPiece.y][selectedPiece.x], board[y][x]);
-                    promotePawnIfNecessary(y, x);
-                }
-
-                pieceSelected = false;
-                moveHints.clear();
-                captureHints.clear();
-
-                if (isCheckmate(Piece::Color::White)) {
-                    handleCheckmate(Piece::Color::Black);
+                int from = toSquare(selectedPiece.x, selectedPiece.y);
+                int to = toSquare(target.x, target.y);
+                PieceType promotion = PieceType::None;
+                if (position.isPromotion(from, to)) {
+                    promotion = choosePromotion(position.sideToMove());
                 }
-                else if (isCheckmate(Piece::Color::Black)) {
-                    handleCheckmate(Piece::Color::White);
+                Move move;
+                if (findLegalMove(from, to, promotion, move)) {
+                    playMove(move);
                 }
-
-                currentPlayer = (currentPlayer == Piece::Color::White) ? Piece::Color::Black : Piece::Color::White;
             }
             else {
                 pieceSelected = false;
                 moveHints.clear();
                 captureHints.clear();
+                dirty = true;
             }
         }
         else {
-            if (board[y][x] != nullptr && board[y][x]->getColor() == currentPlayer) {
+            int square = toSquare(x, y);
+            if (!position.isEmpty(square) && position.colorOn(square) == position.sideToMove()) {
                 selectedPiece = sf::Vector2i(x, y);
                 pieceSelected = true;
                 auto validMoves = getValidMoves(x, y);
                 highlightValidMoves(validMoves);
+                dirty = true;
             }
         }
     }
 }
 
-
-
-
-
-void ChessBoard::promotePawnIfNecessary(int y, int x) {
-    if (dynamic_cast<Pawn*>(board[y][x]) && ((board[y][x]->getColor() == Piece::Color::White && y == 0) ||
-        (board[y][x]->getColor() == Piece::Color::Black && y == 7))) {
-        Piece* promotedPiece = choosePromotion(board[y][x]->getColor());
-        delete board[y][x];
-        board[y][x] = promotedPiece;
-    }
-}
-
-Piece* ChessBoard::choosePromotion(Piece::Color color) {
+PieceType ChessBoard::choosePromotion(Color color) {
     return showPromotionDialog(color);
 }
 
-void ChessBoard::drawBoard(sf::RenderWindow& window) {
-    sf::RectangleShape square(sf::Vector2f(100, 100));
-    bool white = true;
-
-    for (int i = 0; i < 8; ++i) {
-        for (int j = 0; j < 8; ++j) {
-            if ((i + j) % 2 == 0)
-                square.setFillColor(sf::Color::White);
-            else
-                square.setFillColor(sf::Color::Black);
-
-            square.setPosition(i * 100, j * 100);
-            window.draw(square);
-        }
-    }
-} 
-
-void ChessBoard::drawPieces(sf::RenderWindow& window) {
-    for (int i = 0; i < 8; ++i) {
-        for (int j = 0; j < 8; ++j) {
-            if (board[i][j] != nullptr) {
-                board[i][j]->draw(window, j, i);
-            }
-        }
-    }
-}
-
-void ChessBoard::drawHints(sf::RenderWindow& window) {
-    for (const auto& hint : moveHints) {
-        window.draw(hint);
-    }
-    for (const auto& hint : captureHints) {
-        window.draw(hint);
-    }
-}
-
-
 std::vector<sf::Vector2i> ChessBoard::getValidMoves(int x, int y) {
     std::vector<sf::Vector2i> validMoves;
-    if (board[y][x] != nullptr) {
-        auto potentialMoves = board[y][x]->getValidMoves(board, x, y);
-        for (const auto& move : potentialMoves) {
-            if (!wouldBeInCheck(board[y][x], x, y, move.x, move.y)) {
-                validMoves.push_back(move);
-            }
+    MoveList legalMoves;
+    generateLegalMoves(position, legalMoves);
+
+    int from = toSquare(x, y);
+    for (const Move& move : legalMoves) {
+        // Promotions appear once per piece type; the dialog picks the piece.
+        if (move.from() == from && (move.promotion() == PieceType::None || move.promotion() == PieceType::Queen)) {
+            validMoves.push_back(toCell(move.to()));
         }
     }
     return validMoves;
 }
 
-sf::Vector2i ChessBoard::findKing(Piece::Color color) {
-    for (int y = 0; y < 8; ++y) {
-        for (int x = 0; x < 8; ++x) {
-            if (board[y][x] != nullptr && board[y][x]->getColor() == color && dynamic_cast<King*>(board[y][x]) != nullptr) {
-                return sf::Vector2i(x, y);
-            }
+bool ChessBoard::findLegalMove(int from, int to, PieceType promotion, Move& move) {
+    MoveList legalMoves;
+    generateLegalMoves(position, legalMoves);
+    for (const Move& candidate : legalMoves) {
+        if (candidate.from() == from && candidate.to() == to && candidate.promotion() == promotion) {
+            move = candidate;
+            return true;
         }
     }
-    return sf::Vector2i(-1, -1); // FULL ERROR
+    return false;
 }
 
 void ChessBoard::highlightValidMoves(const std::vector<sf::Vector2i>& moves) {
     moveHints.clear();
     captureHints.clear();
     for (const auto& move : moves) {
-        sf::CircleShape hint(15); 
-        hint.setOrigin(15, 15); 
-        hint.setPosition(move.x * 100 + 50, move.y * 100 + 50);
-        if (board[move.y][move.x] == nullptr) {
-            hint.setFillColor(sf::Color::Green);
-            moveHints.push_back(hint);
+        if (position.isEmpty(toSquare(move.x, move.y))) {
+            moveHints.push_back(move);
         }
         else {
-            hint.setFillColor(sf::Color::Red);
-            captureHints.push_back(hint);
+            captureHints.push_back(move);
         }
     }
 }
 
 
-bool ChessBoard::isInCheck(Piece::Color color) {
-    sf::Vector2i kingPos;
-
-    for (int y = 0; y < 8; ++y) {
-        for (int x = 0; x < 8; ++x) {
-            if (board[y][x] != nullptr && board[y][x]->getColor() == color && dynamic_cast<King*>(board[y][x]) != nullptr) {
-                kingPos = sf::Vector2i(x, y);
-                break;
-            }
-        }
-    }
-
-    for (int y = 0; y < 8; ++y) {
-        for (int x = 0; x < 8; ++x) {
-            if (board[y][x] != nullptr && board[y][x]->getColor() != color) {
-                auto moves = board[y][x]->getValidMoves(board, x, y);
-                if (std::find(moves.begin(), moves.end(), kingPos) != moves.end()) {
-                    return true;
-                }
-            }
-        }
-    }
-
-    return false;
+bool ChessBoard::isInCheck(Color color) {
+    return position.isInCheck(color);
 }
 
 
-Piece* ChessBoard::showPromotionDialog(Piece::Color color) {
+PieceType ChessBoard::showPromotionDialog(Color color) {
     sf::RenderWindow promotionWindow(sf::VideoMode(500, 200), "Choose Promotion");
-    sf::Texture queenTexture, rookTexture, bishopTexture, knightTexture;
-    queenTexture.loadFromFile((color == Piece::Color::White) ? "figures/white-queen.png" : "figures/black-queen.png");
-    rookTexture.loadFromFile((color == Piece::Color::White) ? "figures/white-rook.png" : "figures/black-rook.png");
-    bishopTexture.loadFromFile((color == Piece::Color::White) ? "figures/white-bishop.png" : "figures/black-bishop.png");
-    knightTexture.loadFromFile((color == Piece::Color::White) ? "figures/white-knight.png" : "figures/black-knight.png");
-
-    sf::Sprite queenSprite(queenTexture), rookSprite(rookTexture), bishopSprite(bishopTexture), knightSprite(knightTexture);
+    const sf::Texture& texture = atlas.getTexture();
+    sf::Sprite queenSprite(texture, atlas.getRect(color, PieceType::Queen));
+    sf::Sprite rookSprite(texture, atlas.getRect(color, PieceType::Rook));
+    sf::Sprite bishopSprite(texture, atlas.getRect(color, PieceType::Bishop));
+    sf::Sprite knightSprite(texture, atlas.getRect(color, PieceType::Knight));
     queenSprite.setPosition(50, 50);
     rookSprite.setPosition(150, 50);
     bishopSprite.setPosition(250, 50);
@@ -281,83 +277,60 @@ Piece* ChessBoard::showPromotionDialog(Piece::Color color) {
     bishopSprite.setOrigin(bishopSprite.getLocalBounds().width / 2, bishopSprite.getLocalBounds().height / 2);
     knightSprite.setOrigin(knightSprite.getLocalBounds().width / 2, knightSprite.getLocalBounds().height / 2);
 
+    sf::Event event;
+    bool redraw = true;
     while (promotionWindow.isOpen()) {
-        sf::Event event;
-        while (promotionWindow.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) {
+        if (redraw) {
+            promotionWindow.clear(sf::Color::White);
+            promotionWindow.draw(queenSprite);
+            promotionWindow.draw(rookSprite);
+            promotionWindow.draw(bishopSprite);
+            promotionWindow.draw(knightSprite);
+            promotionWindow.display();
+        }
+        // Nothing in the dialog animates, so sleep until the next event.
+        if (!promotionWindow.waitEvent(event)) {
+            break;
+        }
+        redraw = event.type == sf::Event::Resized || event.type == sf::Event::GainedFocus;
+
+        if (event.type == sf::Event::Closed) {
+            promotionWindow.close();
+            return PieceType::Queen;
+        }
+        if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+            sf::Vector2i clickPos = sf::Mouse::getPosition(promotionWindow);
+            if (queenSprite.getGlobalBounds().contains(clickPos.x, clickPos.y)) {
                 promotionWindow.close();
-                return new Queen(color);
+                return PieceType::Queen;
             }
-            if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
-                sf::Vector2i clickPos = sf::Mouse::getPosition(promotionWindow);
-                if (queenSprite.getGlobalBounds().contains(clickPos.x, clickPos.y)) {
-                    promotionWindow.close();
-                    return new Queen(color);
-                }
-                else if (rookSprite.getGlobalBounds().contains(clickPos.x, clickPos.y)) {
-                    promotionWindow.close();
-                    return new Rook(color);
-                }
-                else if (bishopSprite.getGlobalBounds().contains(clickPos.x, clickPos.y)) {
-                    promotionWindow.close();
-                    return new Bishop(color);
-                }
-                else if (knightSprite.getGlobalBounds().contains(clickPos.x, clickPos.y)) {
-                    promotionWindow.close();
-                    return new Knight(color);
-                }
+            else if (rookSprite.getGlobalBounds().contains(clickPos.x, clickPos.y)) {
+                promotionWindow.close();
+                return PieceType::Rook;
+            }
+            else if (bishopSprite.getGlobalBounds().contains(clickPos.x, clickPos.y)) {
+                promotionWindow.close();
+                return PieceType::Bishop;
+            }
+            else if (knightSprite.getGlobalBounds().contains(clickPos.x, clickPos.y)) {
+                promotionWindow.close();
+                return PieceType::Knight;
             }
         }
-        promotionWindow.clear(sf::Color::White);
-        promotionWindow.draw(queenSprite);
-        promotionWindow.draw(rookSprite);
-        promotionWindow.draw(bishopSprite);
-        promotionWindow.draw(knightSprite);
-        promotionWindow.display();
     }
-    return new Queen(color);
+    return PieceType::Queen;
 }
 
-bool ChessBoard::wouldBeInCheck(Piece* movingPiece, int fromX, int fromY, int toX, int toY) {
-    Piece* capturedPiece = board[toY][toX];
-    std::swap(board[fromY][fromX], board[toY][toX]);
-    board[fromY][fromX] = nullptr;
-
-    bool inCheck = isInCheck(movingPiece->getColor());
-
-    std::swap(board[fromY][fromX], board[toY][toX]);
-    board[toY][toX] = capturedPiece;
-
-    return inCheck;
-}
-bool ChessBoard::willMovePreventCheck(int startX, int startY, int endX, int endY, Piece::Color color) {
-    Piece* originalDestPiece = board[endY][endX];
-    board[endY][endX] = board[startY][startX];
-    board[startY][startX] = nullptr;
-    bool inCheck = isInCheck(color);
-    board[startY][startX] = board[endY][endX];
-    board[endY][endX] = originalDestPiece;
-    return !inCheck;
-}
-
-bool ChessBoard::isCheckmate(Piece::Color color) {
-    if (!isInCheck(color)) {
+bool ChessBoard::isCheckmate(Color color) {
+    if (color != position.sideToMove() || !isInCheck(color)) {
         return false;
     }
-    for (int y = 0; y < 8; ++y) {
-        for (int x = 0; x < 8; ++x) {
-            if (board[y][x] != nullptr && board[y][x]->getColor() == color) {
-                auto validMoves = getValidMoves(x, y);
-                if (!validMoves.empty()) {
-                    return false;
-                }
-            }
-        }
-    }
-    return true;
+    MoveList legalMoves;
+    generateLegalMoves(position, legalMoves);
+    return legalMoves.empty();
 }
-void ChessBoard::handleCheckmate(Piece::Color winningColor) {
-    std::string winner = (winningColor == Piece::Color::White) ? "White" : "Black";
+void ChessBoard::handleCheckmate(Color winningColor) {
+    std::string winner = (winningColor == Color::White) ? "White" : "Black";
 
     sf::RenderWindow alertWindow(sf::VideoMode(300, 150), "Checkmate");
     sf::Font font;
@@ -377,26 +350,31 @@ void ChessBoard::handleCheckmate(Piece::Color winningColor) {
     buttonText.setFillColor(sf::Color::White);
     buttonText.setPosition(115, 90);
 
+    sf::Event event;
+    bool redraw = true;
     while (alertWindow.isOpen()) {
-        sf::Event event;
-        while (alertWindow.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) {
+        if (redraw) {
+            alertWindow.clear(sf::Color::White);
+            alertWindow.draw(text);
+            alertWindow.draw(button);
+            alertWindow.draw(buttonText);
+            alertWindow.display();
+        }
+        if (!alertWindow.waitEvent(event)) {
+            break;
+        }
+        redraw = event.type == sf::Event::Resized || event.type == sf::Event::GainedFocus;
+
+        if (event.type == sf::Event::Closed) {
+            alertWindow.close();
+        }
+        if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+            int mouseX = event.mouseButton.x;
+            int mouseY = event.mouseButton.y;
+            if (button.getGlobalBounds().contains(mouseX, mouseY)) {
                 alertWindow.close();
-            }
-            if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
-                int mouseX = event.mouseButton.x;
-                int mouseY = event.mouseButton.y;
-                if (button.getGlobalBounds().contains(mouseX, mouseY)) {
-                    alertWindow.close();
-                    initBoard();
-                }
+                initBoard();
             }
         }
-        alertWindow.clear(sf::Color::White);
-        alertWindow.draw(text);
-        alertWindow.draw(button);
-        alertWindow.draw(buttonText);
-        alertWindow.display();
     }
 }
-
@@ -3,7 +3,10 @@
 
 #include <SFML/Graphics.hpp>
 #include <vector>
-#include "Piece.hpp"
+#include "BoardRenderer.hpp"
+#include "PieceAtlas.hpp"
+#include "Position.hpp"
+#include "EngineThread.hpp"
 
 class ChessBoard {
 public:
@@ -11,31 +14,55 @@ public:
     ~ChessBoard();
     void draw(sf::RenderWindow& window);
     void handleEvent(const sf::Event& event);
+    // True when something visible changed since the last draw.
+    bool needsRedraw() const;
+    // True while a move animation runs; the caller should keep drawing frames.
+    bool isAnimating() const;
+    // Starts the computer's search when it is its turn and plays the reply
+    // once it arrives and the previous move finished animating.
+    void update();
+    // True while the engine thread searches; the caller should keep polling.
+    bool isThinking() const;
     void initBoard();
-    bool isInCheck(Piece::Color color);
-    bool willMovePreventCheck(int startX, int startY, int endX, int endY, Piece::Color color);
-    sf::Vector2i findKing(Piece::Color color);
+    bool isInCheck(Color color);
 private:
-    Piece::Color currentTurn;
-    std::vector<std::vector<Piece*>> board;
+    Position position;
+    PieceAtlas atlas;
+    BoardRenderer renderer;
     bool pieceSelected;
     sf::Vector2i selectedPiece;
-    std::vector<sf::CircleShape> moveHints;
-    std::vector<sf::CircleShape> captureHints;
+    std::vector<sf::Vector2i> moveHints;
+    std::vector<sf::Vector2i> captureHints;
+    sf::Vector2i hoveredCell;
+    bool dirty;
+    bool animating;
+    BoardRenderer::MoveAnimation animation;
+    sf::Clock animationClock;
+    EngineThread engine;
+    // Id of the search whose best move the board waits for, 0 for none.
+    std::uint32_t pendingSearch;
+    bool vsComputer;
+    Color computerColor;
 
-    void drawBoard(sf::RenderWindow& window);
-    void drawPieces(sf::RenderWindow& window);
-    void drawHints(sf::RenderWindow& window);
     std::vector<sf::Vector2i> getValidMoves(int x, int y);
+    // Finds the legal move matching the squares and promotion piece.
+    bool findLegalMove(int from, int to, PieceType promotion, Move& move);
     void highlightValidMoves(const std::vector<sf::Vector2i>& moves);
-    void promotePawnIfNecessary(int y, int x);
-    Piece* choosePromotion(Piece::Color color);
+    PieceType choosePromotion(Color color);
+    void startAnimation(int from, int to);
+    void handleMouseMove(int mouseX, int mouseY);
+    void playMove(const Move& move);
+    void toggleComputer();
+    bool isComputerTurn() const;
 
-    bool wouldBeInCheck(Piece* movingPiece, int fromX, int fromY, int toX, int toY);
-    bool isCheckmate(Piece::Color color);
-    void handleCheckmate(Piece::Color winningColor);
+    bool isCheckmate(Color color);
+    void handleCheckmate(Color winningColor);
 
-    Piece* showPromotionDialog(Piece::Color color);
+    PieceType showPromotionDialog(Color color);
+
+    // Board coordinates on screen have y = 0 at the top (rank 8).
+    static int toSquare(int x, int y) { return makeSquare(x, 7 - y); }
+    static sf::Vector2i toCell(int square) { return sf::Vector2i(fileOf(square), 7 - rankOf(square)); }
 };
 
 #endif // CHESSBOARD_HPP
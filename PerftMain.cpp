@@ -0,0 +1,319 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "MoveGen.hpp"
+#include "Nnue.hpp"
+#include "Perft.hpp"
+#include "Search.hpp"
+
+namespace {
+    void printUsage() {
+        std::cerr << "Usage:\n"
+                  << "  perft <depth> [fen]          count leaf nodes\n"
+                  << "  perft divide <depth> [fen]   count leaf nodes per root move\n"
+                  << "  perft suite [max depth]      check the reference positions (default depth 4)\n"
+                  << "  perft search <depth> [fen]   run the engine to a fixed depth\n"
+                  << "  perft bench [depth] [threads] [hash MB] [option...]\n"
+                  << "                               time the engine to a fixed depth on the bench set;\n"
+                  << "                               each named option (NullMove, LateMoveReductions,\n"
+                  << "                               Futility, ReverseFutility, PVS) is switched off;\n"
+                  << "                               EvalFile=<file> evaluates with that network\n"
+                  << "  perft nnue <file>            check the network's SIMD kernels against the scalar\n"
+                  << "                               one and time them\n";
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void printSpeed(std::uint64_t nodes, double seconds) {
+        std::cout << "Nodes: " << nodes << "\n"
+                  << "Time: " << static_cast<long long>(seconds * 1000) << " ms\n"
+                  << "NPS: " << static_cast<long long>(seconds > 0 ? nodes / seconds : 0) << "\n";
+    }
+
+    std::string joinFen(int argc, char* argv[], int first) {
+        std::string fen;
+        for (int i = first; i < argc; ++i) {
+            if (!fen.empty()) {
+                fen += ' ';
+            }
+            fen += argv[i];
+        }
+        return fen.empty() ? StartFen : fen;
+    }
+
+    int runSuite(int maxDepth) {
+        int failures = 0;
+        std::uint64_t totalNodes = 0;
+        auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < PerftSuiteSize; ++i) {
+            const PerftPosition& entry = PerftSuite[i];
+            Position position;
+            if (!position.setFen(entry.fen)) {
+                std::cout << "FAIL " << entry.name << ": invalid FEN " << entry.fen << "\n";
+                ++failures;
+                continue;
+            }
+            for (int depth = 1; depth <= maxDepth && depth <= 6; ++depth) {
+                std::uint64_t expected = entry.nodes[depth - 1];
+                if (expected == 0) {
+                    continue;
+                }
+                std::uint64_t nodes = perft(position, depth);
+                totalNodes += nodes;
+                bool ok = nodes == expected;
+                std::cout << (ok ? "ok   " : "FAIL ") << entry.name << " depth " << depth
+                          << ": " << nodes;
+                if (!ok) {
+                    std::cout << " (expected " << expected << ")";
+                    ++failures;
+                }
+                std::cout << "\n";
+            }
+        }
+
+        printSpeed(totalNodes, secondsSince(start));
+        std::cout << (failures ? "FAILED: " : "All passed, ") << failures << " failure(s)\n";
+        return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    // Fixed positions for comparing engine speed between builds and thread
+    // counts; a mix of openings, middlegames and endgames.
+    const char* const BenchFens[] = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3",
+        "r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP3PPP/R2QKB1R w KQ - 0 8",
+        "r2q1rk1/1b2bppp/p2ppn2/1p6/3NP3/1BN1B3/PPP2PPP/R2Q1RK1 w - - 0 12",
+        "2r2rk1/pp3ppp/2n1b3/3p4/3P4/2PB1N2/P4PPP/R4RK1 w - - 0 18",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "8/8/4k3/3p4/3P4/4K3/8/8 w - - 0 1",
+        "6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    };
+
+    int runBench(int depth, int threads, int hashMB, const SearchOptions& options, const Nnue::Network* network) {
+        TranspositionTable table;
+        if (!table.resize(hashMB)) {
+            return EXIT_FAILURE;
+        }
+        Search search(table);
+        search.setThreads(threads);
+        search.setOptions(options);
+        search.setNetwork(network);
+
+        SearchLimits limits;
+        limits.depth = depth;
+        std::uint64_t totalNodes = 0;
+        std::uint64_t pawnProbes = 0;
+        std::uint64_t pawnHits = 0;
+        std::vector<std::uint64_t> threadNodes(threads, 0);
+        auto start = std::chrono::steady_clock::now();
+        for (const char* fen : BenchFens) {
+            Position position;
+            if (!position.setFen(fen)) {
+                std::cerr << "Invalid FEN: " << fen << "\n";
+                return EXIT_FAILURE;
+            }
+            table.clear();
+            SearchInfo info = search.think(position, limits);
+            totalNodes += info.nodes;
+            pawnProbes += info.pawnHashProbes;
+            pawnHits += info.pawnHashHits;
+            for (std::size_t i = 0; i < info.threadNodes.size(); ++i) {
+                threadNodes[i] += info.threadNodes[i];
+            }
+            std::cout << "depth " << info.depth << " time " << info.timeMs << " nodes " << info.nodes
+                      << " best " << toUci(info.bestMove) << "  " << fen << "\n";
+        }
+
+        double seconds = secondsSince(start);
+        for (int i = 0; i < threads; ++i) {
+            std::cout << "Thread " << i << " nodes: " << threadNodes[i] << "\n";
+        }
+        std::cout << "Threads: " << threads << "\n";
+        if (pawnProbes > 0) {
+            std::cout << "Pawn hash hits: " << pawnHits * 100 / pawnProbes << "% of " << pawnProbes << " probes\n";
+        }
+        printSpeed(totalNodes, seconds);
+        return EXIT_SUCCESS;
+    }
+
+    // Moves of every bench position, played through the network with
+    // `kernel`: each incremental update must equal a scalar refresh of the
+    // new position, and its score the scalar score.
+    int countMismatches(Nnue::Network& network, Nnue::Kernel kernel) {
+        int mismatches = 0;
+        for (const char* fen : BenchFens) {
+            Position position;
+            if (!position.setFen(fen)) {
+                std::cerr << "Invalid FEN: " << fen << "\n";
+                ++mismatches;
+                continue;
+            }
+            Nnue::Accumulator root, updated, reference;
+            network.setKernel(kernel);
+            network.refresh(position, root);
+            MoveList moves;
+            generateLegalMoves(position, moves);
+            for (const Move& move : moves) {
+                network.setKernel(kernel);
+                network.update(root, Nnue::changesOf(position, move), updated);
+                position.makeMove(move);
+                int score = network.evaluate(updated, position.sideToMove());
+                network.setKernel(Nnue::Kernel::Scalar);
+                network.refresh(position, reference);
+                int expected = network.evaluate(reference, position.sideToMove());
+                position.unmakeMove(move);
+                if (std::memcmp(&updated, &reference, sizeof(updated)) != 0 || score != expected) {
+                    ++mismatches;
+                }
+            }
+        }
+        return mismatches;
+    }
+
+    // Average cost of updating over one move and evaluating the result.
+    double nanosecondsPerEvaluation(Nnue::Network& network, Nnue::Kernel kernel) {
+        network.setKernel(kernel);
+        const int rounds = 100;
+        std::uint64_t evaluations = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const char* fen : BenchFens) {
+            Position position;
+            // countMismatches already reported it.
+            if (!position.setFen(fen)) {
+                continue;
+            }
+            Nnue::Accumulator root, updated;
+            network.refresh(position, root);
+            MoveList moves;
+            generateLegalMoves(position, moves);
+            for (int round = 0; round < rounds; ++round) {
+                for (const Move& move : moves) {
+                    network.update(root, Nnue::changesOf(position, move), updated);
+                    network.evaluate(updated, opposite(position.sideToMove()));
+                    ++evaluations;
+                }
+            }
+        }
+        return evaluations ? secondsSince(start) * 1e9 / evaluations : 0;
+    }
+
+    int runNnue(const std::string& path) {
+        Nnue::Network network;
+        if (!network.load(path)) {
+            return EXIT_FAILURE;
+        }
+        int failures = 0;
+        for (Nnue::Kernel kernel : { Nnue::Kernel::Scalar, Nnue::Kernel::Sse41, Nnue::Kernel::Avx2 }) {
+            std::cout << Nnue::kernelName(kernel) << ": ";
+            if (!Nnue::isSupported(kernel)) {
+                std::cout << "not supported by this CPU\n";
+                continue;
+            }
+            int mismatches = countMismatches(network, kernel);
+            failures += mismatches;
+            std::cout << mismatches << " mismatch(es), update + evaluate "
+                      << static_cast<long long>(nanosecondsPerEvaluation(network, kernel)) << " ns\n";
+        }
+        std::cout << "Best kernel: " << Nnue::kernelName(Nnue::bestKernel()) << "\n"
+                  << (failures ? "FAILED: " : "All passed, ") << failures << " failure(s)\n";
+        return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    void printIteration(const SearchInfo& info) {
+        std::cout << "depth " << info.depth << " score " << info.score << " nodes " << info.nodes
+                  << " time " << info.timeMs << " nps " << info.nps << " best " << toUci(info.bestMove) << "\n";
+    }
+
+    int runSearch(Position& position, int depth) {
+        SearchLimits limits;
+        limits.depth = depth;
+        TranspositionTable table;
+        Search search(table);
+        auto start = std::chrono::steady_clock::now();
+        SearchInfo info = search.think(position, limits, printIteration);
+        printSpeed(info.nodes, secondsSince(start));
+        std::cout << "Depth: " << info.depth << "\n"
+                  << "Best move: " << (info.hasMove ? toUci(info.bestMove) : std::string("(none)")) << "\n";
+        return EXIT_SUCCESS;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Bitboards::init();
+
+    if (argc < 2) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::string command = argv[1];
+    if (command == "suite") {
+        return runSuite(argc > 2 ? std::atoi(argv[2]) : 4);
+    }
+    if (command == "bench") {
+        int depth = argc > 2 ? std::atoi(argv[2]) : 8;
+        int threads = argc > 3 ? std::atoi(argv[3]) : 1;
+        int hashMB = argc > 4 ? std::atoi(argv[4]) : static_cast<int>(TranspositionTable::DefaultSizeMB);
+        if (depth < 1 || threads < 1 || hashMB < 1) {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+        SearchOptions options;
+        Nnue::Network network;
+        for (int i = 5; i < argc; ++i) {
+            if (std::strncmp(argv[i], "EvalFile=", 9) == 0) {
+                if (!network.load(argv[i] + 9)) {
+                    return EXIT_FAILURE;
+                }
+                continue;
+            }
+            bool* flag = options.find(argv[i]);
+            if (!flag) {
+                std::cerr << "Unknown option: " << argv[i] << "\n";
+                return EXIT_FAILURE;
+            }
+            *flag = false;
+        }
+        return runBench(depth, threads, hashMB, options, network.isLoaded() ? &network : nullptr);
+    }
+    if (command == "nnue") {
+        if (argc < 3) {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+        return runNnue(argv[2]);
+    }
+
+    bool divide = command == "divide";
+    bool search = command == "search";
+    int depthArg = (divide || search) ? 2 : 1;
+    if (argc <= depthArg) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+    int depth = std::atoi(argv[depthArg]);
+
+    Position position;
+    std::string fen = joinFen(argc, argv, depthArg + 1);
+    if (depth < 1 || !position.setFen(fen)) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    if (search) {
+        return runSearch(position, depth);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t nodes = divide ? perftDivide(position, depth, std::cout) : perft(position, depth);
+    printSpeed(nodes, secondsSince(start));
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,44 @@
+#include "PieceAtlas.hpp"
+#include <iostream>
+#include <string>
+
+PieceAtlas::PieceAtlas() {
+    const char* names[6] = { "pawn", "knight", "bishop", "rook", "queen", "king" };
+
+    sf::Image atlas;
+    atlas.create(6 * CellSize + WhiteBlockSize, 2 * CellSize, sf::Color::Transparent);
+    for (int y = 0; y < WhiteBlockSize; ++y) {
+        for (int x = 0; x < WhiteBlockSize; ++x) {
+            atlas.setPixel(6 * CellSize + x, y, sf::Color::White);
+        }
+    }
+    for (int c = 0; c < 2; ++c) {
+        for (int t = 0; t < 6; ++t) {
+            std::string relativePath = std::string("figures/") + (c == 0 ? "white-" : "black-") + names[t] + ".png";
+            sf::Image image;
+            if (!image.loadFromFile(relativePath)) {
+                std::cerr << "Failed to load image \"" << relativePath << "\". Please check the file path.\n";
+                continue;
+            }
+            atlas.copy(image, t * CellSize, c * CellSize, sf::IntRect(0, 0, CellSize, CellSize));
+        }
+    }
+
+    if (!texture.loadFromImage(atlas)) {
+        std::cerr << "Failed to create the piece texture atlas.\n";
+    }
+    texture.setSmooth(true);
+}
+
+const sf::Texture& PieceAtlas::getTexture() const {
+    return texture;
+}
+
+sf::IntRect PieceAtlas::getRect(Color color, PieceType type) const {
+    return sf::IntRect(typeIndex(type) * CellSize, colorIndex(color) * CellSize, CellSize, CellSize);
+}
+
+sf::FloatRect PieceAtlas::getWhiteRect() const {
+    // Stay a texel inside the block so smoothing never blends in transparency.
+    return sf::FloatRect(6 * CellSize + 1.f, 1.f, WhiteBlockSize - 2.f, WhiteBlockSize - 2.f);
+}
@@ -0,0 +1,26 @@
+#ifndef PIECEATLAS_HPP
+#define PIECEATLAS_HPP
+
+#include <SFML/Graphics.hpp>
+#include "Types.hpp"
+
+// All twelve piece images packed into one texture: one column per piece
+// type, white on the top row and black on the bottom row, plus a small
+// opaque white block so untextured shapes can share the same draw call.
+// Loaded once and shared by everything that shows a piece.
+class PieceAtlas {
+public:
+    static constexpr int CellSize = 128;
+    static constexpr int WhiteBlockSize = 4;
+
+    PieceAtlas();
+    const sf::Texture& getTexture() const;
+    sf::IntRect getRect(Color color, PieceType type) const;
+    // Texture coordinates that sample plain white, for solid-colored geometry.
+    sf::FloatRect getWhiteRect() const;
+
+private:
+    sf::Texture texture;
+};
+
+#endif // PIECEATLAS_HPP
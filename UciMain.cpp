@@ -0,0 +1,325 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "EngineThread.hpp"
+#include "MoveGen.hpp"
+#include "PawnTable.hpp"
+
+// Universal Chess Interface front-end. The main thread reads commands from
+// stdin and hands them to the engine thread; a second thread prints the
+// engine's results as they arrive, so `stop` and `isready` are answered
+// while a search runs.
+namespace {
+    const char* const EngineName = "Chess2.0";
+    const int MaxHashMB = 65536;
+    const int MaxThreads = 512;
+    const int MaxPawnHashMB = 1024;
+
+    class UciSession {
+    public:
+        UciSession() : engine(1), searching(false), holdBestMove(false), heldBestMove(false),
+                       printer(&UciSession::printResults, this) {
+            position.setStartPosition();
+            engine.setPosition(position);
+        }
+
+        ~UciSession() {
+            engine.shutdown();
+            printer.join();
+        }
+
+        // Returns false on `quit`.
+        bool handle(const std::string& line);
+
+    private:
+        EngineThread engine;
+        Position position;
+        SearchOptions options;
+        // Guards stdout and the search state below, shared with the printer.
+        std::mutex mutex;
+        bool searching;
+        // `go infinite` and `go ponder` must not answer before stop or
+        // ponderhit, even if the search ends on its own.
+        bool holdBestMove;
+        bool heldBestMove;
+        SearchInfo held;
+        std::thread printer;
+
+        void printResults();
+        void printBestMove(const SearchInfo& info);
+        void print(const std::string& text);
+
+        void setPosition(std::istringstream& args);
+        void go(std::istringstream& args);
+        void setOption(std::istringstream& args);
+        void stop();
+        void ponderhit();
+    };
+
+    std::string scoreText(int score) {
+        if (score >= MateScore - MaxPly) {
+            return "mate " + std::to_string((MateScore - score + 1) / 2);
+        }
+        if (score <= -MateScore + MaxPly) {
+            return "mate -" + std::to_string((MateScore + score) / 2);
+        }
+        return "cp " + std::to_string(score);
+    }
+
+    bool parseMove(const Position& position, const std::string& text, Move& move) {
+        MoveList moves;
+        generateLegalMoves(position, moves);
+        for (const Move& candidate : moves) {
+            if (toUci(candidate) == text) {
+                move = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void UciSession::print(const std::string& text) {
+        std::cout << text << std::endl;
+    }
+
+    void UciSession::printBestMove(const SearchInfo& info) {
+        if (info.pawnHashProbes > 0) {
+            print("info string pawn hash hits " + std::to_string(info.pawnHashHits * 100 / info.pawnHashProbes) +
+                  "% of " + std::to_string(info.pawnHashProbes) + " probes");
+        }
+        print("bestmove " + (info.hasMove ? toUci(info.bestMove) : std::string("0000")));
+        searching = false;
+    }
+
+    void UciSession::printResults() {
+        EngineThread::Result result;
+        while (engine.waitResult(result)) {
+            std::lock_guard<std::mutex> lock(mutex);
+            const SearchInfo& info = result.info;
+            switch (result.type) {
+            case EngineThread::Result::Info: {
+                std::ostringstream text;
+                text << "info depth " << info.depth << " score " << scoreText(info.score)
+                     << " nodes " << info.nodes << " nps " << info.nps << " time " << info.timeMs
+                     << " hashfull " << info.hashfull << " pv " << toUci(info.bestMove);
+                print(text.str());
+                break;
+            }
+            case EngineThread::Result::BestMove:
+                if (holdBestMove) {
+                    held = info;
+                    heldBestMove = true;
+                }
+                else {
+                    printBestMove(info);
+                }
+                break;
+            case EngineThread::Result::Ready:
+                print("readyok");
+                break;
+            }
+        }
+    }
+
+    void UciSession::setPosition(std::istringstream& args) {
+        std::string token;
+        args >> token;
+        Position next;
+        if (token == "startpos") {
+            next.setStartPosition();
+            args >> token;
+        }
+        else if (token == "fen") {
+            std::string fen;
+            while (args >> token && token != "moves") {
+                fen += (fen.empty() ? "" : " ") + token;
+            }
+            if (!next.setFen(fen)) {
+                std::cerr << "Invalid FEN: " << fen << "\n";
+                return;
+            }
+        }
+        else {
+            return;
+        }
+
+        if (token == "moves") {
+            while (args >> token) {
+                Move move;
+                if (!parseMove(next, token, move)) {
+                    std::cerr << "Illegal move: " << token << "\n";
+                    break;
+                }
+                next.makeMove(move);
+                // The search plays up to MaxPly moves on top of the game.
+                if (next.gamePly() + MaxPly >= Position::MaxGamePly) {
+                    next.trimHistory();
+                }
+            }
+        }
+        position = next;
+        engine.setPosition(position);
+    }
+
+    void UciSession::go(std::istringstream& args) {
+        SearchLimits limits;
+        bool infinite = false;
+        std::string token;
+        while (args >> token) {
+            long long value = 0;
+            if (token == "infinite") {
+                infinite = true;
+                continue;
+            }
+            if (token == "ponder") {
+                limits.ponder = true;
+                continue;
+            }
+            if (!(args >> value)) {
+                break;
+            }
+            if (token == "depth") limits.depth = static_cast<int>(value);
+            else if (token == "movetime") limits.moveTimeMs = static_cast<int>(value);
+            else if (token == "nodes") limits.nodes = static_cast<std::uint64_t>(value);
+            else if (token == "wtime") limits.timeLeftMs[colorIndex(Color::White)] = static_cast<int>(value);
+            else if (token == "btime") limits.timeLeftMs[colorIndex(Color::Black)] = static_cast<int>(value);
+            else if (token == "winc") limits.incrementMs[colorIndex(Color::White)] = static_cast<int>(value);
+            else if (token == "binc") limits.incrementMs[colorIndex(Color::Black)] = static_cast<int>(value);
+            else if (token == "movestogo") limits.movesToGo = static_cast<int>(value);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        searching = true;
+        holdBestMove = infinite || limits.ponder;
+        heldBestMove = false;
+        engine.go(limits);
+    }
+
+    void UciSession::stop() {
+        std::lock_guard<std::mutex> lock(mutex);
+        holdBestMove = false;
+        if (heldBestMove) {
+            heldBestMove = false;
+            printBestMove(held);
+        }
+        else if (searching) {
+            engine.stop();
+        }
+    }
+
+    void UciSession::ponderhit() {
+        std::lock_guard<std::mutex> lock(mutex);
+        holdBestMove = false;
+        if (heldBestMove) {
+            heldBestMove = false;
+            printBestMove(held);
+        }
+        else {
+            engine.ponderhit();
+        }
+    }
+
+    void UciSession::setOption(std::istringstream& args) {
+        std::string token, name, value;
+        args >> token;  // "name"
+        while (args >> token && token != "value") {
+            name += (name.empty() ? "" : " ") + token;
+        }
+        // The rest of the line, so file names may contain spaces.
+        std::getline(args >> std::ws, value);
+
+        if (name == "Hash") {
+            engine.setHashSize(std::clamp(std::atoi(value.c_str()), 1, MaxHashMB));
+        }
+        else if (name == "PawnHash") {
+            engine.setPawnHashSize(std::clamp(std::atoi(value.c_str()), 1, MaxPawnHashMB));
+        }
+        else if (name == "EvalFile") {
+            engine.setEvalFile(value == "<empty>" ? std::string() : value);
+        }
+        else if (name == "Threads") {
+            engine.setThreads(std::clamp(std::atoi(value.c_str()), 1, MaxThreads));
+        }
+        else if (bool* flag = options.find(name)) {
+            *flag = value == "true";
+            engine.setOptions(options);
+        }
+        else if (name != "Ponder") {
+            std::cerr << "Unknown option: " << name << "\n";
+        }
+    }
+
+    bool UciSession::handle(const std::string& line) {
+        std::istringstream args(line);
+        std::string command;
+        args >> command;
+
+        if (command == "uci") {
+            std::lock_guard<std::mutex> lock(mutex);
+            print(std::string("id name ") + EngineName);
+            print("id author 00DRUG");
+            print("option name Hash type spin default " + std::to_string(TranspositionTable::DefaultSizeMB) +
+                  " min 1 max " + std::to_string(MaxHashMB));
+            print("option name Threads type spin default 1 min 1 max " + std::to_string(MaxThreads));
+            print("option name PawnHash type spin default " + std::to_string(PawnTable::DefaultSizeMB) +
+                  " min 1 max " + std::to_string(MaxPawnHashMB));
+            print("option name Ponder type check default false");
+            print("option name EvalFile type string default <empty>");
+            for (const char* option : SearchOptions::Names) {
+                print(std::string("option name ") + option + " type check default true");
+            }
+            print("uciok");
+        }
+        else if (command == "isready") {
+            std::lock_guard<std::mutex> lock(mutex);
+            // A ping would end a running search, and nothing but the search
+            // can be pending while one runs.
+            if (searching) {
+                print("readyok");
+            }
+            else {
+                engine.ping();
+            }
+        }
+        else if (command == "ucinewgame") {
+            engine.newGame();
+        }
+        else if (command == "position") {
+            setPosition(args);
+        }
+        else if (command == "go") {
+            go(args);
+        }
+        else if (command == "stop") {
+            stop();
+        }
+        else if (command == "ponderhit") {
+            ponderhit();
+        }
+        else if (command == "setoption") {
+            setOption(args);
+        }
+        else if (command == "quit") {
+            return false;
+        }
+        else if (!command.empty()) {
+            std::cerr << "Unknown command: " << command << "\n";
+        }
+        return true;
+    }
+}
+
+int main() {
+    Bitboards::init();
+    std::ios::sync_with_stdio(false);
+
+    UciSession session;
+    std::string line;
+    while (std::getline(std::cin, line) && session.handle(line)) {
+    }
+    return EXIT_SUCCESS;
+}
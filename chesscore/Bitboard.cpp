@@ -0,0 +1,186 @@
+#include "Bitboard.hpp"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Bitboards {
+    Bitboard PawnAttacks[2][64];
+    Bitboard KnightAttacks[64];
+    Bitboard KingAttacks[64];
+
+    Bitboard BetweenBB[64][64];
+    Bitboard LineBB[64][64];
+
+    bool UsePext = false;
+    Magic RookMagics[64];
+    Magic BishopMagics[64];
+}
+
+namespace {
+    const int RookDirections[4][2] = { {1, 0}, {-1, 0}, {0, 1}, {0, -1} };
+    const int BishopDirections[4][2] = { {1, 1}, {-1, 1}, {1, -1}, {-1, -1} };
+
+    // Every square's slice is 2^(relevant bits) entries: 102400 for rooks,
+    // 5248 for bishops.
+    Bitboard RookTable[0x19000];
+    Bitboard BishopTable[0x1480];
+
+    Bitboard stepAttack(int square, int fileStep, int rankStep) {
+        int file = fileOf(square) + fileStep;
+        int rank = rankOf(square) + rankStep;
+        if (file < 0 || file > 7 || rank < 0 || rank > 7) {
+            return 0;
+        }
+        return squareBB(makeSquare(file, rank));
+    }
+
+    // Square-by-square ray walk, only used to fill the magic tables.
+    Bitboard slidingAttacks(int square, Bitboard occupied, const int directions[4][2]) {
+        Bitboard attacks = 0;
+        for (int d = 0; d < 4; ++d) {
+            int file = fileOf(square) + directions[d][0];
+            int rank = rankOf(square) + directions[d][1];
+            while (file >= 0 && file < 8 && rank >= 0 && rank < 8) {
+                Bitboard target = squareBB(makeSquare(file, rank));
+                attacks |= target;
+                if (occupied & target) {
+                    break;
+                }
+                file += directions[d][0];
+                rank += directions[d][1];
+            }
+        }
+        return attacks;
+    }
+
+    bool cpuHasBmi2() {
+#if defined(CHESS_HAS_PEXT) && defined(_MSC_VER)
+        int regs[4];
+        __cpuidex(regs, 7, 0);
+        return (regs[1] & (1 << 8)) != 0;
+#elif defined(CHESS_HAS_PEXT)
+        return __builtin_cpu_supports("bmi2");
+#else
+        return false;
+#endif
+    }
+
+    // xorshift64* generator; fixed seeds keep start-up time deterministic.
+    class MagicRandom {
+    public:
+        explicit MagicRandom(std::uint64_t seed) : state(seed) {}
+
+        std::uint64_t next() {
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return state * 2685821657736338717ULL;
+        }
+
+        // Magics with few set bits are found much faster.
+        std::uint64_t sparse() {
+            return next() & next() & next();
+        }
+
+    private:
+        std::uint64_t state;
+    };
+
+    void initMagics(Bitboard table[], Bitboards::Magic magics[], const int directions[4][2]) {
+        const std::uint64_t seeds[8] = { 728, 10316, 55013, 32803, 12281, 15100, 16645, 255 };
+
+        Bitboard occupancy[4096];
+        Bitboard reference[4096];
+        int epoch[4096] = {};
+        int attempt = 0;
+
+        for (int square = 0; square < 64; ++square) {
+            Bitboards::Magic& m = magics[square];
+
+            // Board edges never block a ray, so they are left out of the mask.
+            Bitboard rankEdges = (Rank1BB | Rank8BB) & ~(Rank1BB << (8 * rankOf(square)));
+            Bitboard fileEdges = (FileABB | FileHBB) & ~(FileABB << fileOf(square));
+            m.mask = slidingAttacks(square, 0, directions) & ~(rankEdges | fileEdges);
+            m.shift = 64 - popCount(m.mask);
+            m.magic = 0;
+            m.attacks = (square == 0) ? table : magics[square - 1].attacks + (std::size_t(1) << (64 - magics[square - 1].shift));
+
+            // Enumerate every subset of the mask (Carry-Rippler trick).
+            int size = 0;
+            Bitboard b = 0;
+            do {
+                occupancy[size] = b;
+                reference[size] = slidingAttacks(square, b, directions);
+                if (Bitboards::UsePext) {
+                    m.attacks[pext(b, m.mask)] = reference[size];
+                }
+                ++size;
+                b = (b - m.mask) & m.mask;
+            } while (b);
+
+            if (Bitboards::UsePext) {
+                continue;
+            }
+
+            MagicRandom rng(seeds[rankOf(square)]);
+            for (int i = 0; i < size;) {
+                do {
+                    m.magic = rng.sparse();
+                } while (popCount((m.magic * m.mask) >> 56) < 6);
+
+                ++attempt;
+                for (i = 0; i < size; ++i) {
+                    unsigned idx = m.index(occupancy[i]);
+                    if (epoch[idx] < attempt) {
+                        epoch[idx] = attempt;
+                        m.attacks[idx] = reference[i];
+                    }
+                    else if (m.attacks[idx] != reference[i]) {
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void Bitboards::init() {
+    const int knightSteps[8][2] = { {1, 2}, {1, -2}, {-1, 2}, {-1, -2}, {2, 1}, {2, -1}, {-2, 1}, {-2, -1} };
+    const int kingSteps[8][2] = { {1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {-1, -1}, {1, -1}, {-1, 1} };
+
+    for (int square = 0; square < 64; ++square) {
+        PawnAttacks[colorIndex(Color::White)][square] = stepAttack(square, -1, 1) | stepAttack(square, 1, 1);
+        PawnAttacks[colorIndex(Color::Black)][square] = stepAttack(square, -1, -1) | stepAttack(square, 1, -1);
+
+        KnightAttacks[square] = 0;
+        KingAttacks[square] = 0;
+        for (int i = 0; i < 8; ++i) {
+            KnightAttacks[square] |= stepAttack(square, knightSteps[i][0], knightSteps[i][1]);
+            KingAttacks[square] |= stepAttack(square, kingSteps[i][0], kingSteps[i][1]);
+        }
+    }
+
+    UsePext = cpuHasBmi2();
+    initMagics(RookTable, RookMagics, RookDirections);
+    initMagics(BishopTable, BishopMagics, BishopDirections);
+
+    for (int from = 0; from < 64; ++from) {
+        for (int to = 0; to < 64; ++to) {
+            BetweenBB[from][to] = 0;
+            LineBB[from][to] = 0;
+            if (from == to) {
+                continue;
+            }
+            Bitboard ends = squareBB(from) | squareBB(to);
+            if (rookAttacks(from, 0) & squareBB(to)) {
+                LineBB[from][to] = (rookAttacks(from, 0) & rookAttacks(to, 0)) | ends;
+                BetweenBB[from][to] = rookAttacks(from, squareBB(to)) & rookAttacks(to, squareBB(from));
+            }
+            else if (bishopAttacks(from, 0) & squareBB(to)) {
+                LineBB[from][to] = (bishopAttacks(from, 0) & bishopAttacks(to, 0)) | ends;
+                BetweenBB[from][to] = bishopAttacks(from, squareBB(to)) & bishopAttacks(to, squareBB(from));
+            }
+        }
+    }
+}
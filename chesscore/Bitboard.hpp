@@ -0,0 +1,184 @@
+#ifndef BITBOARD_HPP
+#define BITBOARD_HPP
+
+#include <bit>
+#include <cstdint>
+#include "Types.hpp"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <immintrin.h>
+#define CHESS_HAS_PEXT 1
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#include <immintrin.h>
+#define CHESS_HAS_PEXT 1
+#endif
+
+// One bit per square, a1 = bit 0, h1 = bit 7, a8 = bit 56.
+using Bitboard = std::uint64_t;
+
+constexpr Bitboard FileABB = 0x0101010101010101ULL;
+constexpr Bitboard FileHBB = FileABB << 7;
+constexpr Bitboard Rank1BB = 0xFFULL;
+constexpr Bitboard Rank2BB = Rank1BB << 8;
+constexpr Bitboard Rank3BB = Rank1BB << 16;
+constexpr Bitboard Rank6BB = Rank1BB << 40;
+constexpr Bitboard Rank7BB = Rank1BB << 48;
+constexpr Bitboard Rank8BB = Rank1BB << 56;
+
+constexpr int makeSquare(int file, int rank) {
+    return rank * 8 + file;
+}
+
+constexpr int fileOf(int square) {
+    return square & 7;
+}
+
+constexpr int rankOf(int square) {
+    return square >> 3;
+}
+
+constexpr Bitboard squareBB(int square) {
+    return Bitboard(1) << square;
+}
+
+// Moves every bit one step; +8 is one rank up, +1 one file right. Bits
+// that would wrap around the board edge are dropped.
+template<int Step>
+constexpr Bitboard shift(Bitboard b) {
+    if constexpr (Step == 8) return b << 8;
+    else if constexpr (Step == -8) return b >> 8;
+    else if constexpr (Step == 7) return (b & ~FileABB) << 7;
+    else if constexpr (Step == 9) return (b & ~FileHBB) << 9;
+    else if constexpr (Step == -7) return (b & ~FileHBB) >> 7;
+    else if constexpr (Step == -9) return (b & ~FileABB) >> 9;
+    else if constexpr (Step == 1) return (b & ~FileHBB) << 1;
+    else if constexpr (Step == -1) return (b & ~FileABB) >> 1;
+    else static_assert(Step == 8, "Unsupported shift");
+}
+
+inline int popCount(Bitboard b) {
+    return std::popcount(b);
+}
+
+inline int lsb(Bitboard b) {
+    return std::countr_zero(b);
+}
+
+inline int popLsb(Bitboard& b) {
+    int square = lsb(b);
+    b &= b - 1;
+    return square;
+}
+
+// Parallel bit extract. Only called when Bitboards::UsePext says the CPU
+// supports BMI2; the portable loop keeps other targets compiling.
+#if defined(CHESS_HAS_PEXT) && defined(_MSC_VER)
+inline Bitboard pext(Bitboard b, Bitboard mask) {
+    return _pext_u64(b, mask);
+}
+#elif defined(CHESS_HAS_PEXT)
+__attribute__((target("bmi2"))) inline Bitboard pext(Bitboard b, Bitboard mask) {
+    return _pext_u64(b, mask);
+}
+#else
+inline Bitboard pext(Bitboard b, Bitboard mask) {
+    Bitboard result = 0;
+    for (Bitboard bit = 1; mask; bit <<= 1) {
+        if (b & mask & (0 - mask)) {
+            result |= bit;
+        }
+        mask &= mask - 1;
+    }
+    return result;
+}
+#endif
+
+namespace Bitboards {
+    // Fills the attack tables. Must run once before any Position is used.
+    void init();
+
+    // True when the slider tables were laid out for BMI2 PEXT indexing.
+    extern bool UsePext;
+
+    // Fancy magic entry for one square: the relevant occupancy mask is
+    // hashed to an index into that square's slice of the attack table.
+    struct Magic {
+        Bitboard mask;
+        Bitboard magic;
+        Bitboard* attacks;
+        unsigned shift;
+
+        unsigned index(Bitboard occupied) const {
+            if (UsePext) {
+                return static_cast<unsigned>(pext(occupied, mask));
+            }
+            return static_cast<unsigned>(((occupied & mask) * magic) >> shift);
+        }
+    };
+
+    extern Magic RookMagics[64];
+    extern Magic BishopMagics[64];
+
+    // Squares strictly between two aligned squares, and the full line
+    // through them; both are empty when the squares share no line.
+    extern Bitboard BetweenBB[64][64];
+    extern Bitboard LineBB[64][64];
+
+    extern Bitboard PawnAttacks[2][64];
+    extern Bitboard KnightAttacks[64];
+    extern Bitboard KingAttacks[64];
+
+    inline Bitboard pawnAttacks(Color color, int square) {
+        return PawnAttacks[colorIndex(color)][square];
+    }
+
+    // Squares attacked by all pawns of one color at once.
+    inline Bitboard pawnAttacks(Color color, Bitboard pawns) {
+        if (color == Color::White) {
+            return shift<7>(pawns) | shift<9>(pawns);
+        }
+        return shift<-9>(pawns) | shift<-7>(pawns);
+    }
+
+    inline Bitboard knightAttacks(int square) {
+        return KnightAttacks[square];
+    }
+
+    inline Bitboard kingAttacks(int square) {
+        return KingAttacks[square];
+    }
+
+    inline Bitboard rookAttacks(int square, Bitboard occupied) {
+        const Magic& m = RookMagics[square];
+        return m.attacks[m.index(occupied)];
+    }
+
+    inline Bitboard bishopAttacks(int square, Bitboard occupied) {
+        const Magic& m = BishopMagics[square];
+        return m.attacks[m.index(occupied)];
+    }
+
+    inline Bitboard queenAttacks(int square, Bitboard occupied) {
+        return rookAttacks(square, occupied) | bishopAttacks(square, occupied);
+    }
+
+    // Attacks of a non-pawn piece type chosen at compile time.
+    template<PieceType Type>
+    inline Bitboard attacks(int square, Bitboard occupied) {
+        if constexpr (Type == PieceType::Knight) return knightAttacks(square);
+        else if constexpr (Type == PieceType::Bishop) return bishopAttacks(square, occupied);
+        else if constexpr (Type == PieceType::Rook) return rookAttacks(square, occupied);
+        else if constexpr (Type == PieceType::Queen) return queenAttacks(square, occupied);
+        else return kingAttacks(square);
+    }
+
+    inline Bitboard between(int from, int to) {
+        return BetweenBB[from][to];
+    }
+
+    inline Bitboard line(int from, int to) {
+        return LineBB[from][to];
+    }
+}
+
+#endif // BITBOARD_HPP
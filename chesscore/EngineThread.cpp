@@ -0,0 +1,223 @@
+#include "EngineThread.hpp"
+#include <utility>
+
+EngineThread::EngineThread(int threads)
+    : search(table), results(std::make_unique<SpscQueue<Result, 256>>()), commandSignal(0), resultSignal(0),
+      ponderhitId(0), finished(false), quitting(false), nextSearchId(0) {
+    search.setThreads(threads);
+    // A go before any position searches the initial one, never an empty board.
+    root.setStartPosition();
+    thread = std::thread(&EngineThread::run, this);
+}
+
+EngineThread::~EngineThread() {
+    shutdown();
+}
+
+void EngineThread::newGame() {
+    Command command;
+    command.type = Command::NewGame;
+    post(std::move(command));
+}
+
+void EngineThread::setPosition(const Position& position) {
+    Command command;
+    command.type = Command::SetPosition;
+    command.position = std::make_unique<Position>(position);
+    post(std::move(command));
+}
+
+void EngineThread::setHashSize(std::size_t megabytes) {
+    Command command;
+    command.type = Command::SetHashSize;
+    command.value = megabytes;
+    post(std::move(command));
+}
+
+void EngineThread::setThreads(int threads) {
+    Command command;
+    command.type = Command::SetThreads;
+    command.value = static_cast<std::size_t>(threads);
+    post(std::move(command));
+}
+
+void EngineThread::setPawnHashSize(std::size_t megabytes) {
+    Command command;
+    command.type = Command::SetPawnHashSize;
+    command.value = megabytes;
+    post(std::move(command));
+}
+
+void EngineThread::setOptions(const SearchOptions& options) {
+    Command command;
+    command.type = Command::SetOptions;
+    command.options = options;
+    post(std::move(command));
+}
+
+void EngineThread::setEvalFile(const std::string& path) {
+    Command command;
+    command.type = Command::SetEvalFile;
+    command.path = path;
+    post(std::move(command));
+}
+
+std::uint32_t EngineThread::go(const SearchLimits& limits) {
+    Command command;
+    command.type = Command::Go;
+    command.searchId = ++nextSearchId;
+    command.limits = limits;
+    post(std::move(command));
+    return nextSearchId;
+}
+
+void EngineThread::ponderhit() {
+    // Not a queued command: anything in the queue would end the search.
+    ponderhitId.store(nextSearchId, std::memory_order_release);
+}
+
+void EngineThread::stop() {
+    Command command;
+    command.type = Command::Stop;
+    post(std::move(command));
+}
+
+void EngineThread::ping() {
+    Command command;
+    command.type = Command::Ping;
+    post(std::move(command));
+}
+
+void EngineThread::shutdown() {
+    if (!thread.joinable()) {
+        return;
+    }
+    // A best move waiting for room in a full result queue would otherwise
+    // keep the engine thread from ever reading the Quit.
+    quitting.store(true, std::memory_order_release);
+    Command command;
+    command.type = Command::Quit;
+    post(std::move(command));
+    thread.join();
+}
+
+bool EngineThread::pollResult(Result& result) {
+    return results->pop(result);
+}
+
+bool EngineThread::waitResult(Result& result) {
+    for (;;) {
+        std::uint32_t seen = resultSignal.load(std::memory_order_acquire);
+        if (results->pop(result)) {
+            return true;
+        }
+        if (finished.load(std::memory_order_acquire)) {
+            return false;
+        }
+        resultSignal.wait(seen, std::memory_order_acquire);
+    }
+}
+
+void EngineThread::post(Command command) {
+    // The queue only fills up if the engine thread is stuck; wait it out
+    // rather than lose a command.
+    while (!commands.push(std::move(command))) {
+        std::this_thread::yield();
+    }
+    commandSignal.fetch_add(1, std::memory_order_release);
+    commandSignal.notify_one();
+}
+
+void EngineThread::postResult(Result result, bool mustDeliver) {
+    // Iteration reports are dropped if the caller stops taking results;
+    // best moves are not, unless the engine is shutting down.
+    while (!results->push(std::move(result))) {
+        if (!mustDeliver || quitting.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::this_thread::yield();
+    }
+    resultSignal.fetch_add(1, std::memory_order_release);
+    resultSignal.notify_all();
+}
+
+void EngineThread::run() {
+    Command command;
+    for (;;) {
+        std::uint32_t seen = commandSignal.load(std::memory_order_acquire);
+        if (!commands.pop(command)) {
+            commandSignal.wait(seen, std::memory_order_acquire);
+            continue;
+        }
+
+        switch (command.type) {
+        case Command::NewGame:
+            table.clear();
+            break;
+        case Command::SetPosition:
+            root = *command.position;
+            break;
+        case Command::SetHashSize:
+            table.resize(command.value);
+            break;
+        case Command::SetThreads:
+            search.setThreads(static_cast<int>(command.value));
+            break;
+        case Command::SetPawnHashSize:
+            search.setPawnHashSize(command.value);
+            break;
+        case Command::SetOptions:
+            search.setOptions(command.options);
+            break;
+        case Command::SetEvalFile:
+            if (command.path.empty()) {
+                network.unload();
+            }
+            else {
+                network.load(command.path);
+            }
+            search.setNetwork(network.isLoaded() ? &network : nullptr);
+            break;
+        case Command::Go:
+            runSearch(command);
+            break;
+        case Command::Stop:
+            // Only a running search has anything to stop, and the command
+            // reaching the queue already ended it.
+            break;
+        case Command::Ping: {
+            Result result;
+            result.type = Result::Ready;
+            postResult(std::move(result), true);
+            break;
+        }
+        case Command::Quit:
+            finished.store(true, std::memory_order_release);
+            resultSignal.fetch_add(1, std::memory_order_release);
+            resultSignal.notify_all();
+            return;
+        }
+    }
+}
+
+void EngineThread::runSearch(const Command& command) {
+    SearchLimits limits = command.limits;
+    std::uint32_t searchId = command.searchId;
+    // Any command waiting in the queue ends the search.
+    limits.interrupted = [this] { return !commands.empty(); };
+    limits.ponderhit = [this, searchId] { return ponderhitId.load(std::memory_order_acquire) == searchId; };
+
+    SearchInfo info = search.think(root, limits, [this, searchId](const SearchInfo& iteration) {
+        Result result;
+        result.type = Result::Info;
+        result.searchId = searchId;
+        result.info = iteration;
+        postResult(std::move(result), false);
+    });
+
+    Result result;
+    result.type = Result::BestMove;
+    result.searchId = searchId;
+    result.info = std::move(info);
+    postResult(std::move(result), true);
+}
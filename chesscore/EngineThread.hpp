@@ -0,0 +1,125 @@
+#ifndef ENGINETHREAD_HPP
+#define ENGINETHREAD_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include "Nnue.hpp"
+#include "Position.hpp"
+#include "Search.hpp"
+#include "SpscQueue.hpp"
+#include "TranspositionTable.hpp"
+
+// Runs the engine on its own thread so the caller never waits for a search.
+// Commands go in and results come out through lock-free queues; the caller
+// polls or waits for results from its own loop. A new command interrupts
+// whatever search is running, so stop, a new position or a new go take
+// effect within a few thousand nodes.
+//
+// Commands must all come from one thread and results must all be taken by
+// one thread, which may be a different one.
+class EngineThread {
+public:
+    struct Result {
+        enum Type : std::uint8_t {
+            Info,       // one completed iteration
+            BestMove,   // the search finished; info holds the final result
+            Ready       // every command before ping() has been handled
+        };
+        Type type = Info;
+        // The id returned by go() for the search that produced it.
+        std::uint32_t searchId = 0;
+        SearchInfo info;
+    };
+
+    explicit EngineThread(int threads = 1);
+    ~EngineThread();
+    EngineThread(const EngineThread&) = delete;
+    EngineThread& operator=(const EngineThread&) = delete;
+
+    // Forgets everything learned from the previous game.
+    void newGame();
+    void setPosition(const Position& position);
+    void setHashSize(std::size_t megabytes);
+    void setThreads(int threads);
+    // Per search thread.
+    void setPawnHashSize(std::size_t megabytes);
+    void setOptions(const SearchOptions& options);
+    // Evaluates with the network in `path`, or classically when `path` is
+    // empty. A file that fails to load is reported to std::cerr and the
+    // evaluation in use is kept.
+    void setEvalFile(const std::string& path);
+    // Searches the last position set within `limits`. Returns an id that
+    // tags the results of this search. With `limits.ponder` set the search
+    // ignores its limits until ponderhit().
+    std::uint32_t go(const SearchLimits& limits);
+    // The opponent played the expected move: the pondering search now runs
+    // on our own clock. Does not interrupt the search.
+    void ponderhit();
+    void stop();
+    // Answered with a Ready result once all earlier commands are done.
+    void ping();
+    // Ends the engine thread; waitResult returns false afterwards.
+    void shutdown();
+
+    // Takes the next result if there is one.
+    bool pollResult(Result& result);
+    // Takes the next result, sleeping until one arrives. Returns false once
+    // the engine has shut down and no results are left.
+    bool waitResult(Result& result);
+
+private:
+    struct Command {
+        enum Type : std::uint8_t {
+            NewGame,
+            SetPosition,
+            SetHashSize,
+            SetThreads,
+            SetPawnHashSize,
+            SetOptions,
+            SetEvalFile,
+            Go,
+            Stop,
+            Ping,
+            Quit
+        };
+        Type type = Stop;
+        std::uint32_t searchId = 0;
+        std::size_t value = 0;
+        // Only for SetPosition; a Position is far bigger than the rest of
+        // the command and would make every queue slot that big.
+        std::unique_ptr<Position> position;
+        SearchLimits limits;
+        SearchOptions options;
+        std::string path;
+    };
+
+    TranspositionTable table;
+    Nnue::Network network;
+    Search search;
+    SpscQueue<Command, 16> commands;
+    // On the heap: EngineThread is often a member of an object on the stack.
+    std::unique_ptr<SpscQueue<Result, 256>> results;
+    // Bumped with every command and every result; the receiving thread
+    // sleeps on them when its queue is empty.
+    std::atomic<std::uint32_t> commandSignal;
+    std::atomic<std::uint32_t> resultSignal;
+    std::atomic<std::uint32_t> ponderhitId;
+    std::atomic<bool> finished;
+    // Set by shutdown(); from then on nobody is bound to take results.
+    std::atomic<bool> quitting;
+    std::uint32_t nextSearchId;
+    // Only touched by the engine thread.
+    Position root;
+    std::thread thread;
+
+    void post(Command command);
+    void run();
+    void runSearch(const Command& command);
+    void postResult(Result result, bool mustDeliver);
+};
+
+#endif // ENGINETHREAD_HPP
@@ -0,0 +1,162 @@
+#include "Evaluate.hpp"
+#include <algorithm>
+
+namespace {
+    // Per square a piece can move to beyond a typical count, for knight,
+    // bishop, rook and queen. Squares attacked by enemy pawns do not count.
+    constexpr Score MobilityWeights[4] = { { 4, 4 }, { 5, 5 }, { 2, 4 }, { 1, 2 } };
+    constexpr int MobilityBase[4] = { 4, 6, 7, 13 };
+
+    constexpr Score DoubledPawn = { -10, -20 };
+    constexpr Score IsolatedPawn = { -10, -15 };
+    // A pawn that no pawn of ours can protect and whose stop square an
+    // enemy pawn controls.
+    constexpr Score BackwardPawn = { -8, -10 };
+    // Passed pawns by rank from their own side, the first rank first.
+    constexpr Score PassedPawn[8] = {
+        { 0, 0 }, { 5, 10 }, { 10, 20 }, { 20, 35 }, { 35, 60 }, { 60, 100 }, { 100, 150 }, { 0, 0 } };
+    // A passed pawn with an enemy piece on its stop square.
+    constexpr Score BlockedPassedPawn = { -5, -20 };
+
+    // A pawn in front of its king, on the king's file or next to it.
+    constexpr Score PawnShield = { 12, 0 };
+    // King attack units per square of the king zone a piece attacks, for
+    // knight, bishop, rook and queen. The penalty grows with the square of
+    // the units once two pieces take part.
+    constexpr int KingAttackWeights[4] = { 2, 2, 3, 5 };
+    constexpr int MaxKingDanger = 400;
+
+    Bitboard fillUp(Bitboard b) {
+        b |= b << 8;
+        b |= b << 16;
+        return b | (b << 32);
+    }
+
+    Bitboard fillDown(Bitboard b) {
+        b |= b >> 8;
+        b |= b >> 16;
+        return b | (b >> 32);
+    }
+
+    // The squares in front of each pawn, towards promotion.
+    template<Color Us>
+    Bitboard frontSpans(Bitboard pawns) {
+        return (Us == Color::White) ? fillUp(shift<8>(pawns)) : fillDown(shift<-8>(pawns));
+    }
+
+    // Scores our pawn structure and records our passed pawns in `entry`.
+    template<Color Us>
+    Score evaluatePawns(const Position& position, PawnTable::Entry& entry) {
+        constexpr Color Them = opposite(Us);
+        constexpr int Down = (Us == Color::White) ? -8 : 8;
+        Bitboard pawns = position.pieces(Us, PieceType::Pawn);
+        Bitboard theirPawns = position.pieces(Them, PieceType::Pawn);
+        Bitboard theirSpans = frontSpans<Them>(theirPawns);
+        Bitboard files = fillUp(pawns) | fillDown(pawns);
+        Bitboard isolated = pawns & ~(shift<1>(files) | shift<-1>(files));
+        // Squares on a neighbouring file level with or ahead of one of our
+        // pawns, which that pawn can still come up to protect.
+        Bitboard spans = frontSpans<Us>(pawns) | pawns;
+        Bitboard supportable = shift<1>(spans) | shift<-1>(spans);
+
+        Score score{};
+        // Every pawn with one of ours ahead of it on its file.
+        score += DoubledPawn * popCount(pawns & frontSpans<Them>(pawns));
+        score += IsolatedPawn * popCount(isolated);
+        Bitboard stopsAttacked = shift<Down>(Bitboards::pawnAttacks(Them, theirPawns));
+        score += BackwardPawn * popCount(pawns & ~isolated & ~supportable & stopsAttacked);
+
+        Bitboard passed = pawns & ~(theirSpans | shift<1>(theirSpans) | shift<-1>(theirSpans));
+        entry.passed[colorIndex(Us)] = passed;
+        while (passed) {
+            int square = popLsb(passed);
+            score += PassedPawn[(Us == Color::White) ? rankOf(square) : 7 - rankOf(square)];
+        }
+        return score;
+    }
+
+    const PawnTable::Entry& probePawns(const Position& position, PawnTable& pawnTable) {
+        bool found;
+        PawnTable::Entry& entry = pawnTable.probe(position.pawnKey(), found);
+        if (!found) {
+            entry.key = position.pawnKey();
+            entry.score = evaluatePawns<Color::White>(position, entry) - evaluatePawns<Color::Black>(position, entry);
+        }
+        return entry;
+    }
+
+    // The parts of passed-pawn play that depend on other pieces.
+    template<Color Us>
+    Score evaluatePassedPawns(const Position& position, Bitboard passed) {
+        constexpr int Up = (Us == Color::White) ? 8 : -8;
+        return BlockedPassedPawn * popCount(shift<Up>(passed) & position.pieces(opposite(Us)));
+    }
+
+    // Attacks on the enemy king zone, gathered while scoring mobility.
+    struct KingAttack {
+        Bitboard zone;
+        int attackers;
+        int units;
+    };
+
+    template<Color Us, PieceType Type>
+    Score evaluateMobility(const Position& position, Bitboard area, KingAttack& kingAttack) {
+        constexpr int Index = typeIndex(Type) - typeIndex(PieceType::Knight);
+        Bitboard occupied = position.occupied();
+        Bitboard pieces = position.pieces(Us, Type);
+        Score score{};
+        while (pieces) {
+            Bitboard attacks = Bitboards::attacks<Type>(popLsb(pieces), occupied);
+            score += MobilityWeights[Index] * (popCount(attacks & area) - MobilityBase[Index]);
+            if (Bitboard zoneAttacks = attacks & kingAttack.zone) {
+                ++kingAttack.attackers;
+                kingAttack.units += KingAttackWeights[Index] * popCount(zoneAttacks);
+            }
+        }
+        return score;
+    }
+
+    // Mobility of our pieces, and how hard they press on the enemy king.
+    template<Color Us>
+    Score evaluatePieces(const Position& position) {
+        constexpr Color Them = opposite(Us);
+        Bitboard area = ~position.pieces(Us) & ~Bitboards::pawnAttacks(Them, position.pieces(Them, PieceType::Pawn));
+        int theirKing = position.kingSquare(Them);
+        KingAttack kingAttack = { Bitboards::kingAttacks(theirKing) | squareBB(theirKing), 0, 0 };
+
+        Score score = evaluateMobility<Us, PieceType::Knight>(position, area, kingAttack)
+            + evaluateMobility<Us, PieceType::Bishop>(position, area, kingAttack)
+            + evaluateMobility<Us, PieceType::Rook>(position, area, kingAttack)
+            + evaluateMobility<Us, PieceType::Queen>(position, area, kingAttack);
+        if (kingAttack.attackers >= 2) {
+            int danger = std::min(kingAttack.units * kingAttack.units / 4, MaxKingDanger);
+            score.mg = static_cast<std::int16_t>(score.mg + danger);
+        }
+        return score;
+    }
+
+    template<Color Us>
+    Score evaluateKingShelter(const Position& position) {
+        constexpr int Up = (Us == Color::White) ? 8 : -8;
+        int king = position.kingSquare(Us);
+        Bitboard shelter = shift<Up>(Bitboards::kingAttacks(king) | squareBB(king));
+        shelter |= shift<Up>(shelter);
+        Bitboard front = (Us == Color::White) ? fillUp(shift<8>(Rank1BB << (8 * rankOf(king))))
+            : fillDown(shift<-8>(Rank1BB << (8 * rankOf(king))));
+        return PawnShield * popCount(position.pieces(Us, PieceType::Pawn) & shelter & front);
+    }
+
+    template<Color Us>
+    Score evaluateSide(const Position& position, const PawnTable::Entry& pawns) {
+        return evaluatePassedPawns<Us>(position, pawns.passed[colorIndex(Us)]) + evaluatePieces<Us>(position)
+            + evaluateKingShelter<Us>(position);
+    }
+}
+
+int evaluate(const Position& position, PawnTable& pawnTable) {
+    const PawnTable::Entry& pawns = probePawns(position, pawnTable);
+    Score score = position.psqScore() + pawns.score
+        + evaluateSide<Color::White>(position, pawns) - evaluateSide<Color::Black>(position, pawns);
+    int value = Psqt::taper(score, position.phase());
+    return position.sideToMove() == Color::White ? value : -value;
+}
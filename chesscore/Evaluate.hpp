@@ -0,0 +1,14 @@
+#ifndef EVALUATE_HPP
+#define EVALUATE_HPP
+
+#include "PawnTable.hpp"
+#include "Position.hpp"
+
+// Static score of the position in centipawns from the side to move's point
+// of view, tapered between middlegame and endgame by the game phase. The
+// material and piece-square part is kept up to date by Position and the
+// pawn structure comes from `pawnTable` when it was seen before; mobility
+// and king safety are computed here.
+int evaluate(const Position& position, PawnTable& pawnTable);
+
+#endif // EVALUATE_HPP
@@ -0,0 +1,112 @@
+#include "MappedFile.hpp"
+#include <iostream>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile() : address(nullptr), length(0), mapping(nullptr) {
+}
+#else
+MappedFile::MappedFile() : address(nullptr), length(0) {
+}
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+void MappedFile::swap(MappedFile& other) {
+    std::swap(address, other.address);
+    std::swap(length, other.length);
+#ifdef _WIN32
+    std::swap(mapping, other.mapping);
+#endif
+}
+
+#ifdef _WIN32
+bool MappedFile::open(const std::string& path) {
+    close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "Cannot open " << path << ".\n";
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        std::cerr << "Cannot map " << path << ": empty or unreadable file.\n";
+        CloseHandle(file);
+        return false;
+    }
+    // The mapping keeps the file open on its own.
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    address = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!address) {
+        std::cerr << "Cannot map " << path << ".\n";
+        close();
+        return false;
+    }
+    length = static_cast<std::size_t>(fileSize.QuadPart);
+    return true;
+}
+
+void MappedFile::close() {
+    if (address) {
+        UnmapViewOfFile(address);
+    }
+    if (mapping) {
+        CloseHandle(mapping);
+    }
+    address = nullptr;
+    mapping = nullptr;
+    length = 0;
+}
+#else
+bool MappedFile::open(const std::string& path) {
+    close();
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        std::cerr << "Cannot open " << path << ".\n";
+        return false;
+    }
+    struct stat status;
+    if (fstat(file, &status) != 0 || status.st_size == 0) {
+        std::cerr << "Cannot map " << path << ": empty or unreadable file.\n";
+        ::close(file);
+        return false;
+    }
+    // The mapping keeps the file open on its own.
+    void* memory = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED, file, 0);
+    ::close(file);
+    if (memory == MAP_FAILED) {
+        std::cerr << "Cannot map " << path << ".\n";
+        return false;
+    }
+    address = memory;
+    length = static_cast<std::size_t>(status.st_size);
+    return true;
+}
+
+void MappedFile::close() {
+    if (address) {
+        munmap(address, length);
+    }
+    address = nullptr;
+    length = 0;
+}
+#endif
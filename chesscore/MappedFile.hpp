@@ -0,0 +1,37 @@
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <string>
+
+// A whole file mapped read-only into memory. The pages come from the
+// operating system's file cache, so every process that maps the same file
+// shares one copy of it.
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Maps `path`, replacing any file mapped before. Reports to std::cerr
+    // and returns false, leaving nothing mapped, if the file cannot be
+    // opened or mapped.
+    bool open(const std::string& path);
+    void close();
+    // Exchanges the mapped files of the two objects.
+    void swap(MappedFile& other);
+
+    bool isOpen() const { return address != nullptr; }
+    const unsigned char* data() const { return static_cast<const unsigned char*>(address); }
+    std::size_t size() const { return length; }
+
+private:
+    void* address;
+    std::size_t length;
+#ifdef _WIN32
+    void* mapping;
+#endif
+};
+
+#endif // MAPPEDFILE_HPP
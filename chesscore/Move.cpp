@@ -0,0 +1,20 @@
+#include "Move.hpp"
+
+std::string squareName(int square) {
+    std::string name;
+    name += static_cast<char>('a' + fileOf(square));
+    name += static_cast<char>('1' + rankOf(square));
+    return name;
+}
+
+std::string toUci(const Move& move) {
+    std::string text = squareName(move.from()) + squareName(move.to());
+    switch (move.promotion()) {
+    case PieceType::Queen: text += 'q'; break;
+    case PieceType::Rook: text += 'r'; break;
+    case PieceType::Bishop: text += 'b'; break;
+    case PieceType::Knight: text += 'n'; break;
+    default: break;
+    }
+    return text;
+}
@@ -0,0 +1,91 @@
+#ifndef MOVE_HPP
+#define MOVE_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Bitboard.hpp"
+
+// A move packed into 16 bits:
+//   bits  0-5   from square
+//   bits  6-11  to square
+//   bits 12-13  promotion piece, knight to queen
+//   bits 14-15  move type
+// The default move is a1a1, which is never legal and serves as "no move".
+class Move {
+public:
+    enum Type : std::uint16_t {
+        Normal = 0,
+        Promotion = 1 << 14,
+        EnPassant = 2 << 14,
+        Castling = 3 << 14
+    };
+
+    constexpr Move() : data(0) {}
+    constexpr Move(int from, int to)
+        : data(static_cast<std::uint16_t>(from | (to << 6))) {}
+    constexpr Move(int from, int to, Type type, PieceType promotion = PieceType::Knight)
+        : data(static_cast<std::uint16_t>(from | (to << 6) | ((typeIndex(promotion) - typeIndex(PieceType::Knight)) << 12) | type)) {}
+
+    static constexpr Move fromRaw(std::uint16_t raw) {
+        Move move;
+        move.data = raw;
+        return move;
+    }
+
+    constexpr int from() const { return data & 63; }
+    constexpr int to() const { return (data >> 6) & 63; }
+    constexpr Type type() const { return static_cast<Type>(data & (3 << 14)); }
+    constexpr PieceType promotion() const {
+        return type() == Promotion ? static_cast<PieceType>(((data >> 12) & 3) + typeIndex(PieceType::Knight)) : PieceType::None;
+    }
+    constexpr std::uint16_t raw() const { return data; }
+
+    constexpr bool operator==(const Move& other) const { return data == other.data; }
+    constexpr bool operator!=(const Move& other) const { return data != other.data; }
+
+private:
+    std::uint16_t data;
+};
+
+// Fixed-capacity list of moves on the stack; no legal position has more
+// than 218 moves.
+class MoveList {
+public:
+    static constexpr std::size_t Capacity = 256;
+
+    MoveList() : count(0) {}
+
+    void push_back(const Move& move) {
+        assert(count < Capacity);
+        moves[count++] = move;
+    }
+    void clear() { count = 0; }
+    // Shrinks the list to its first `size` moves.
+    void resize(std::size_t size) {
+        assert(size <= count);
+        count = size;
+    }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    Move& operator[](std::size_t index) { return moves[index]; }
+    const Move& operator[](std::size_t index) const { return moves[index]; }
+    Move* begin() { return moves; }
+    Move* end() { return moves + count; }
+    const Move* begin() const { return moves; }
+    const Move* end() const { return moves + count; }
+
+private:
+    Move moves[Capacity];
+    std::size_t count;
+};
+
+std::string squareName(int square);
+
+// Long algebraic notation as used by UCI, e.g. "e2e4" or "e7e8q".
+std::string toUci(const Move& move);
+
+#endif // MOVE_HPP
@@ -0,0 +1,290 @@
+#include "MoveGen.hpp"
+
+namespace {
+    // Which moves a generator pass produces. Captures and Quiets split the
+    // legal moves between them the way isQuietMove does: every capture and
+    // queen promotion is a capture, non-capturing underpromotions are quiet.
+    enum class GenType { All, Captures, Quiets };
+
+    const PieceType PromotionTypes[4] = { PieceType::Queen, PieceType::Rook, PieceType::Bishop, PieceType::Knight };
+
+    void addMoves(int from, Bitboard targets, MoveList& moves) {
+        while (targets) {
+            moves.push_back(Move(from, popLsb(targets)));
+        }
+    }
+
+    template<GenType Type>
+    void addPromotions(int from, int to, bool capture, MoveList& moves) {
+        for (PieceType piece : PromotionTypes) {
+            bool tactical = capture || piece == PieceType::Queen;
+            if (Type == GenType::All || (Type == GenType::Captures) == tactical) {
+                moves.push_back(Move(from, to, Move::Promotion, piece));
+            }
+        }
+    }
+
+    // Pawn moves whose destinations were found set-wise; every pawn moved
+    // by the same step, so the origin is the destination minus that step.
+    // Only the diagonal steps capture.
+    template<int Step, GenType Type>
+    void addPawnMoves(Bitboard targets, Bitboard promotionRank, MoveList& moves) {
+        constexpr bool Capture = Step % 8 != 0;
+        Bitboard promotions = targets & promotionRank;
+        targets &= ~promotionRank;
+        while (targets) {
+            int to = popLsb(targets);
+            moves.push_back(Move(to - Step, to));
+        }
+        while (promotions) {
+            int to = popLsb(promotions);
+            addPromotions<Type>(to - Step, to, Capture, moves);
+        }
+    }
+
+    // Our pieces that are the only blocker between our king and an enemy slider.
+    Bitboard pinnedPieces(const Position& position, Color us, int king) {
+        using namespace Bitboards;
+        Color them = opposite(us);
+        Bitboard queens = position.pieces(them, PieceType::Queen);
+        Bitboard snipers = (rookAttacks(king, 0) & (position.pieces(them, PieceType::Rook) | queens))
+            | (bishopAttacks(king, 0) & (position.pieces(them, PieceType::Bishop) | queens));
+
+        Bitboard pinned = 0;
+        while (snipers) {
+            Bitboard blockers = between(king, popLsb(snipers)) & position.occupied();
+            if (blockers && (blockers & (blockers - 1)) == 0) {
+                pinned |= blockers & position.pieces(us);
+            }
+        }
+        return pinned;
+    }
+
+    // En passant removes two pawns from one rank, so it can expose the king
+    // along that rank even when neither pawn is pinned on its own.
+    bool isLegalEnPassant(const Position& position, int from, int to, int king) {
+        Color us = position.sideToMove();
+        int captured = to - ((us == Color::White) ? 8 : -8);
+        Bitboard occupied = (position.occupied() ^ squareBB(from) ^ squareBB(captured)) | squareBB(to);
+        Bitboard attackers = position.attackersTo(king, occupied) & position.pieces(opposite(us));
+        return (attackers & ~squareBB(captured)) == 0;
+    }
+
+    // Knight, bishop, rook or queen moves. A pinned piece keeps to the line
+    // through its king; a pinned knight can never stay on it.
+    template<PieceType Type>
+    void addPieceMoves(const Position& position, Color us, Bitboard targetMask, Bitboard pinned, int king,
+                       MoveList& moves) {
+        Bitboard occupied = position.occupied();
+        Bitboard pieces = position.pieces(us, Type);
+        if constexpr (Type == PieceType::Knight) {
+            pieces &= ~pinned;
+        }
+        while (pieces) {
+            int from = popLsb(pieces);
+            Bitboard targets = Bitboards::attacks<Type>(from, occupied) & targetMask;
+            if (pinned & squareBB(from)) {
+                targets &= Bitboards::line(king, from);
+            }
+            addMoves(from, targets, moves);
+        }
+    }
+
+    template<Color Us, GenType Type>
+    void addAllPawnMoves(const Position& position, Bitboard checkMask, Bitboard pinned, int king, MoveList& moves) {
+        constexpr Color Them = opposite(Us);
+        constexpr int Up = (Us == Color::White) ? 8 : -8;
+        constexpr int UpLeft = (Us == Color::White) ? 7 : -9;
+        constexpr int UpRight = (Us == Color::White) ? 9 : -7;
+        constexpr Bitboard DoublePushRank = (Us == Color::White) ? Rank3BB : Rank6BB;
+        constexpr Bitboard PromotionRank = (Us == Color::White) ? Rank8BB : Rank1BB;
+
+        Bitboard empty = ~position.occupied();
+        Bitboard enemy = position.pieces(Them);
+        Bitboard pawns = position.pieces(Us, PieceType::Pawn);
+
+        // Pushes belong to the captures only when they promote; captures
+        // never belong to the quiet moves.
+        Bitboard pushMask = (Type == GenType::Captures) ? PromotionRank : ~Bitboard(0);
+        Bitboard captureMask = (Type == GenType::Quiets) ? Bitboard(0) : enemy;
+
+        // Unpinned pawns move together, one shift per direction.
+        Bitboard free = pawns & ~pinned;
+        Bitboard single = shift<Up>(free) & empty;
+        addPawnMoves<Up, Type>(single & checkMask & pushMask, PromotionRank, moves);
+        if constexpr (Type != GenType::Captures) {
+            Bitboard twice = shift<Up>(single & DoublePushRank) & empty;
+            addPawnMoves<Up + Up, Type>(twice & checkMask, 0, moves);
+        }
+        addPawnMoves<UpLeft, Type>(shift<UpLeft>(free) & captureMask & checkMask, PromotionRank, moves);
+        addPawnMoves<UpRight, Type>(shift<UpRight>(free) & captureMask & checkMask, PromotionRank, moves);
+
+        // Pinned pawns are rare; each keeps to the line through its king.
+        Bitboard pinnedPawns = pawns & pinned;
+        while (pinnedPawns) {
+            int from = popLsb(pinnedPawns);
+            Bitboard fromBB = squareBB(from);
+            Bitboard push = shift<Up>(fromBB) & empty;
+            Bitboard targets = ((push | (shift<Up>(push & DoublePushRank) & empty)) & pushMask)
+                | (Bitboards::pawnAttacks(Us, from) & captureMask);
+            targets &= checkMask & Bitboards::line(king, from);
+            while (targets) {
+                int to = popLsb(targets);
+                if (squareBB(to) & PromotionRank) {
+                    addPromotions<Type>(from, to, !position.isEmpty(to), moves);
+                }
+                else {
+                    moves.push_back(Move(from, to));
+                }
+            }
+        }
+
+        int epSquare = position.enPassantSquare();
+        if (Type != GenType::Quiets && epSquare != NoSquare) {
+            Bitboard capturers = Bitboards::pawnAttacks(Them, epSquare) & pawns;
+            while (capturers) {
+                int from = popLsb(capturers);
+                if (isLegalEnPassant(position, from, epSquare, king)) {
+                    moves.push_back(Move(from, epSquare, Move::EnPassant));
+                }
+            }
+        }
+    }
+
+    template<Color Us, GenType Type>
+    void generate(const Position& position, MoveList& moves) {
+        using namespace Bitboards;
+        constexpr Color Them = opposite(Us);
+        Bitboard own = position.pieces(Us);
+        Bitboard occupied = position.occupied();
+        Bitboard targetMask = (Type == GenType::Captures) ? position.pieces(Them)
+            : (Type == GenType::Quiets) ? ~occupied : ~own;
+        int king = position.kingSquare(Us);
+
+        Bitboard checkers = position.checkers();
+
+        // The king must not shield the squares it retreats to along a ray.
+        Bitboard kinglessOccupancy = occupied ^ squareBB(king);
+        Bitboard kingTargets = kingAttacks(king) & targetMask;
+        while (kingTargets) {
+            int to = popLsb(kingTargets);
+            if (!position.isSquareAttacked(to, Them, kinglessOccupancy)) {
+                moves.push_back(Move(king, to));
+            }
+        }
+
+        // In double check only the king can move.
+        if (checkers & (checkers - 1)) {
+            return;
+        }
+
+        // Squares that resolve a single check: capture the checker or block it.
+        Bitboard checkMask = ~Bitboard(0);
+        if (checkers) {
+            checkMask = between(king, lsb(checkers)) | checkers;
+        }
+        else if constexpr (Type != GenType::Captures) {
+            Bitboard castlingTargets = position.castlingTargets();
+            while (castlingTargets) {
+                moves.push_back(Move(king, popLsb(castlingTargets), Move::Castling));
+            }
+        }
+
+        Bitboard pinned = pinnedPieces(position, Us, king);
+        targetMask &= checkMask;
+        addPieceMoves<PieceType::Knight>(position, Us, targetMask, pinned, king, moves);
+        addPieceMoves<PieceType::Bishop>(position, Us, targetMask, pinned, king, moves);
+        addPieceMoves<PieceType::Rook>(position, Us, targetMask, pinned, king, moves);
+        addPieceMoves<PieceType::Queen>(position, Us, targetMask, pinned, king, moves);
+        addAllPawnMoves<Us, Type>(position, checkMask, pinned, king, moves);
+    }
+    template<GenType Type>
+    void generateFor(const Position& position, MoveList& moves) {
+        if (position.sideToMove() == Color::White) {
+            generate<Color::White, Type>(position, moves);
+        }
+        else {
+            generate<Color::Black, Type>(position, moves);
+        }
+    }
+}
+
+void generateLegalMoves(const Position& position, MoveList& moves) {
+    generateFor<GenType::All>(position, moves);
+}
+
+void generateLegalCaptures(const Position& position, MoveList& moves) {
+    generateFor<GenType::Captures>(position, moves);
+}
+
+void generateLegalQuiets(const Position& position, MoveList& moves) {
+    generateFor<GenType::Quiets>(position, moves);
+}
+
+bool isQuietMove(const Position& position, const Move& move) {
+    return position.isEmpty(move.to()) && move.type() != Move::EnPassant && move.promotion() != PieceType::Queen;
+}
+
+bool isLegalMove(const Position& position, const Move& move) {
+    using namespace Bitboards;
+    Color us = position.sideToMove();
+    Color them = opposite(us);
+    int from = move.from();
+    int to = move.to();
+    Bitboard own = position.pieces(us);
+    if (!(own & squareBB(from)) || (own & squareBB(to))) {
+        return false;
+    }
+
+    PieceType type = position.pieceTypeOn(from);
+    Bitboard occupied = position.occupied();
+    int king = position.kingSquare(us);
+    switch (move.type()) {
+    case Move::Castling:
+        return type == PieceType::King && (position.castlingTargets() & squareBB(to)) && !position.checkers();
+    case Move::EnPassant:
+        return type == PieceType::Pawn && to == position.enPassantSquare() &&
+            (pawnAttacks(us, from) & squareBB(to)) && isLegalEnPassant(position, from, to, king);
+    default:
+        break;
+    }
+
+    if (type == PieceType::Pawn) {
+        // A pawn reaching the last rank has to promote, and only a pawn may.
+        Bitboard promotionRank = (us == Color::White) ? Rank8BB : Rank1BB;
+        if (((squareBB(to) & promotionRank) != 0) != (move.type() == Move::Promotion)) {
+            return false;
+        }
+        int up = (us == Color::White) ? 8 : -8;
+        int startRank = (us == Color::White) ? 1 : 6;
+        bool reachable = (pawnAttacks(us, from) & position.pieces(them) & squareBB(to))
+            || (to == from + up && !(occupied & squareBB(to)))
+            || (to == from + 2 * up && rankOf(from) == startRank &&
+                !(occupied & (squareBB(from + up) | squareBB(to))));
+        if (!reachable) {
+            return false;
+        }
+    }
+    else if (move.type() != Move::Normal) {
+        return false;
+    }
+    else if (type == PieceType::King) {
+        return (kingAttacks(from) & squareBB(to)) && !position.isSquareAttacked(to, them, occupied ^ squareBB(from));
+    }
+    else {
+        Bitboard attacks = type == PieceType::Knight ? knightAttacks(from)
+            : type == PieceType::Bishop ? bishopAttacks(from, occupied)
+            : type == PieceType::Rook ? rookAttacks(from, occupied)
+            : queenAttacks(from, occupied);
+        if (!(attacks & squareBB(to))) {
+            return false;
+        }
+    }
+
+    // Any other piece has to resolve a check and keep to its pin line.
+    Bitboard checkers = position.checkers();
+    if (checkers && ((checkers & (checkers - 1)) || !((between(king, lsb(checkers)) | checkers) & squareBB(to)))) {
+        return false;
+    }
+    return !(pinnedPieces(position, us, king) & squareBB(from)) || (line(king, from) & squareBB(to));
+}
@@ -0,0 +1,32 @@
+#ifndef MOVEGEN_HPP
+#define MOVEGEN_HPP
+
+#include "Move.hpp"
+#include "Position.hpp"
+
+// Fully legal moves for the side to move. Checkers and pinned pieces are
+// computed once up front, so no move has to be played to be validated.
+// Appends to `moves`; nothing is allocated. The side to move and each piece
+// type are template parameters inside, so the per-piece loops carry no
+// runtime dispatch.
+void generateLegalMoves(const Position& position, MoveList& moves);
+
+// The legal captures, en passant and capturing underpromotions included,
+// and queen promotions: the tactical subset quiescence search looks at.
+void generateLegalCaptures(const Position& position, MoveList& moves);
+
+// The legal moves generateLegalCaptures leaves out: non-captures, castling
+// and underpromotions that capture nothing. Captures and quiets together
+// are all legal moves.
+void generateLegalQuiets(const Position& position, MoveList& moves);
+
+// True for the moves generateLegalQuiets produces: neither a capture nor a
+// queen promotion. These are the moves that killers, history and
+// countermoves order.
+bool isQuietMove(const Position& position, const Move& move);
+
+// True if `move`, which may come from another position (a hash or killer
+// move), is legal here exactly as encoded.
+bool isLegalMove(const Position& position, const Move& move);
+
+#endif // MOVEGEN_HPP
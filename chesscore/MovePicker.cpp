@@ -0,0 +1,201 @@
+#include "MovePicker.hpp"
+#include <cstdlib>
+#include <utility>
+#include "MoveGen.hpp"
+#include "See.hpp"
+
+namespace {
+    // Captures and queen promotions outrank every quiet move among evasions.
+    const int CaptureScore = 1 << 20;
+
+    // MVV-LVA: most valuable victim first, cheapest attacker breaks ties. A
+    // queen promotion counts as winning a queen.
+    int captureScore(const Position& position, const Move& move) {
+        PieceType victim = move.type() == Move::EnPassant ? PieceType::Pawn : position.pieceTypeOn(move.to());
+        int score = (victim == PieceType::None) ? 0 : typeIndex(victim) * 8;
+        if (move.promotion() == PieceType::Queen) {
+            score += typeIndex(PieceType::Queen) * 8;
+        }
+        return score - typeIndex(position.pieceTypeOn(move.from()));
+    }
+}
+
+void MoveHistory::clear() {
+    for (int piece = 0; piece < 16; ++piece) {
+        for (int square = 0; square < 64; ++square) {
+            scores[piece][square] = 0;
+            counterMoves[piece][square] = Move();
+        }
+    }
+}
+
+void MoveHistory::update(Piece piece, int to, int bonus) {
+    int& entry = scores[static_cast<int>(piece)][to];
+    entry += bonus - entry * std::abs(bonus) / MaxScore;
+}
+
+MovePicker::MovePicker(const Position& position, const Move& hashMove, const Move killers[2],
+                       const Move& counterMove, const MoveHistory& history)
+    : position(position), history(history), hashMove(hashMove), refutationCount(0), refutationIndex(0),
+      current(0), badIndex(0) {
+    bool inCheck = position.checkers() != 0;
+    afterHashMove = inCheck ? Stage::GenerateEvasions : Stage::GenerateCaptures;
+    stage = (hashMove != Move() && isLegalMove(position, hashMove)) ? Stage::HashMove : afterHashMove;
+    if (!inCheck) {
+        for (const Move& move : { killers[0], killers[1], counterMove }) {
+            if (move != Move() && move != hashMove && !isRefutation(move)) {
+                refutations[refutationCount++] = move;
+            }
+        }
+    }
+}
+
+MovePicker::MovePicker(const Position& position, const MoveHistory& history)
+    : position(position), history(history), refutationCount(0), refutationIndex(0), current(0), badIndex(0) {
+    stage = position.checkers() ? Stage::GenerateEvasions : Stage::GenerateQuiescence;
+    afterHashMove = stage;
+}
+
+bool MovePicker::isRefutation(const Move& move) const {
+    for (int i = 0; i < refutationCount; ++i) {
+        if (refutations[i] == move) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void MovePicker::scoreCaptures() {
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        scores[i] = captureScore(position, moves[i]);
+    }
+}
+
+void MovePicker::scoreQuiets() {
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        scores[i] = history.score(position.pieceOn(moves[i].from()), moves[i].to());
+    }
+}
+
+void MovePicker::scoreEvasions() {
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        const Move& move = moves[i];
+        scores[i] = isQuietMove(position, move) ? history.score(position.pieceOn(move.from()), move.to())
+            : CaptureScore + captureScore(position, move);
+    }
+}
+
+Move MovePicker::pickBest() {
+    std::size_t best = current;
+    for (std::size_t i = current + 1; i < moves.size(); ++i) {
+        if (scores[i] > scores[best]) {
+            best = i;
+        }
+    }
+    std::swap(moves[current], moves[best]);
+    std::swap(scores[current], scores[best]);
+    return moves[current++];
+}
+
+Move MovePicker::next() {
+    while (true) {
+        switch (stage) {
+        case Stage::HashMove:
+            stage = afterHashMove;
+            return hashMove;
+
+        case Stage::GenerateCaptures:
+            generateLegalCaptures(position, moves);
+            scoreCaptures();
+            stage = Stage::GoodCaptures;
+            break;
+
+        case Stage::GoodCaptures:
+            while (current < moves.size()) {
+                Move move = pickBest();
+                if (move == hashMove) {
+                    continue;
+                }
+                if (losesExchange(position, move)) {
+                    badCaptures.push_back(move);
+                    continue;
+                }
+                return move;
+            }
+            stage = Stage::Refutations;
+            break;
+
+        case Stage::Refutations:
+            while (refutationIndex < refutationCount) {
+                Move& move = refutations[refutationIndex++];
+                if (isQuietMove(position, move) && isLegalMove(position, move)) {
+                    return move;
+                }
+                // Not played here, so the quiet moves must not skip it.
+                move = Move();
+            }
+            stage = Stage::GenerateQuiets;
+            break;
+
+        case Stage::GenerateQuiets:
+            moves.clear();
+            current = 0;
+            generateLegalQuiets(position, moves);
+            scoreQuiets();
+            stage = Stage::Quiets;
+            break;
+
+        case Stage::Quiets:
+            while (current < moves.size()) {
+                Move move = pickBest();
+                if (move != hashMove && !isRefutation(move)) {
+                    return move;
+                }
+            }
+            stage = Stage::BadCaptures;
+            break;
+
+        case Stage::BadCaptures:
+            if (badIndex < badCaptures.size()) {
+                return badCaptures[badIndex++];
+            }
+            stage = Stage::Done;
+            break;
+
+        case Stage::GenerateEvasions:
+            generateLegalMoves(position, moves);
+            scoreEvasions();
+            stage = Stage::Evasions;
+            break;
+
+        case Stage::Evasions:
+            while (current < moves.size()) {
+                Move move = pickBest();
+                if (move != hashMove) {
+                    return move;
+                }
+            }
+            stage = Stage::Done;
+            break;
+
+        case Stage::GenerateQuiescence:
+            generateLegalCaptures(position, moves);
+            scoreCaptures();
+            stage = Stage::QuiescenceCaptures;
+            break;
+
+        case Stage::QuiescenceCaptures:
+            while (current < moves.size()) {
+                Move move = pickBest();
+                if (!losesExchange(position, move)) {
+                    return move;
+                }
+            }
+            stage = Stage::Done;
+            break;
+
+        case Stage::Done:
+            return Move();
+        }
+    }
+}
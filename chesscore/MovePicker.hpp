@@ -0,0 +1,74 @@
+#ifndef MOVEPICKER_HPP
+#define MOVEPICKER_HPP
+
+#include "Move.hpp"
+#include "Position.hpp"
+
+// Quiet-move statistics of one search thread, indexed by the moving piece's
+// code and the destination square: a history score that grows with every
+// cutoff the move causes, and the quiet move that last refuted a move.
+struct MoveHistory {
+    static constexpr int MaxScore = 1 << 14;
+
+    int scores[16][64];
+    Move counterMoves[16][64];
+
+    void clear();
+    // Adds `bonus` (negative to punish) with gravity, so scores saturate
+    // at +-MaxScore and old results fade as new ones arrive.
+    void update(Piece piece, int to, int bonus);
+    int score(Piece piece, int to) const { return scores[static_cast<int>(piece)][to]; }
+};
+
+// Hands out the legal moves of a position one at a time, best guess first,
+// generating each group only when the previous one is used up:
+//   1. the hash move,
+//   2. captures and queen promotions that do not lose material, by MVV-LVA,
+//   3. the two killer moves of the ply and the countermove,
+//   4. the remaining quiet moves by history score,
+//   5. captures that lose material.
+// In check all evasions are generated at once after the hash move. The
+// quiescence form yields only the captures that do not lose material, or
+// all evasions in check.
+class MovePicker {
+public:
+    MovePicker(const Position& position, const Move& hashMove, const Move killers[2], const Move& counterMove,
+               const MoveHistory& history);
+    MovePicker(const Position& position, const MoveHistory& history);
+
+    // The next move to try, or Move() when there are none left.
+    Move next();
+
+private:
+    enum class Stage {
+        HashMove, GenerateCaptures, GoodCaptures, Refutations, GenerateQuiets, Quiets, BadCaptures,
+        GenerateEvasions, Evasions,
+        GenerateQuiescence, QuiescenceCaptures,
+        Done
+    };
+
+    const Position& position;
+    const MoveHistory& history;
+    Stage stage;
+    Stage afterHashMove;
+    Move hashMove;
+    // Killers and countermove, tried in that order; the ones played are
+    // skipped among the quiet moves, the others cleared.
+    Move refutations[3];
+    int refutationCount;
+    int refutationIndex;
+    MoveList moves;
+    int scores[MoveList::Capacity];
+    std::size_t current;
+    MoveList badCaptures;
+    std::size_t badIndex;
+
+    void scoreCaptures();
+    void scoreQuiets();
+    void scoreEvasions();
+    // Moves the best remaining move to `current` and returns it.
+    Move pickBest();
+    bool isRefutation(const Move& move) const;
+};
+
+#endif // MOVEPICKER_HPP
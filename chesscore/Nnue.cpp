@@ -0,0 +1,373 @@
+#include "Nnue.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <iostream>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <immintrin.h>
+#include <intrin.h>
+#define CHESS_HAS_X86_SIMD 1
+#define CHESS_TARGET(isa)
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#include <immintrin.h>
+#define CHESS_HAS_X86_SIMD 1
+#define CHESS_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+static_assert(std::endian::native == std::endian::little, "Network files are read in place as little-endian");
+
+namespace {
+    using namespace Nnue;
+
+    constexpr char Magic[4] = { 'C', 'H', 'N', 'N' };
+    constexpr std::uint32_t Version = 1;
+    constexpr std::size_t HeaderSize = 64;
+    constexpr std::size_t FeatureBiasesOffset = HeaderSize;
+    constexpr std::size_t FeatureWeightsOffset = FeatureBiasesOffset + HalfSize * sizeof(std::int16_t);
+    constexpr std::size_t HiddenBiasesOffset = FeatureWeightsOffset + Features * HalfSize * sizeof(std::int16_t);
+    constexpr std::size_t HiddenWeightsOffset = HiddenBiasesOffset + HiddenSize * sizeof(std::int32_t);
+    constexpr std::size_t OutputBiasOffset = HiddenWeightsOffset + HiddenSize * 2 * HalfSize;
+    constexpr std::size_t OutputWeightsOffset = OutputBiasOffset + sizeof(std::int32_t);
+    constexpr std::size_t FileSize = OutputWeightsOffset + HiddenSize;
+    static_assert(HiddenBiasesOffset % 4 == 0 && OutputBiasOffset % 4 == 0, "int32 sections must stay aligned");
+
+    // A refresh passes one row per occupied square.
+    constexpr int MaxRows = 64;
+
+    // output = input + every added row - every removed row, HalfSize wide.
+    using UpdateRows = void (*)(const std::int16_t* input, std::int16_t* output, const std::int16_t* const* added,
+                                int addedCount, const std::int16_t* const* removed, int removedCount);
+    // Clips both halves to 0..127 and computes the clipped hidden layer.
+    using HiddenLayer = void (*)(const std::int16_t* us, const std::int16_t* them, const std::int8_t* weights,
+                                 const std::int32_t* biases, std::uint8_t* hidden);
+
+    std::uint8_t clipNeuron(int value) {
+        return static_cast<std::uint8_t>(std::clamp(value, 0, 127));
+    }
+
+    void updateRowsScalar(const std::int16_t* input, std::int16_t* output, const std::int16_t* const* added,
+                          int addedCount, const std::int16_t* const* removed, int removedCount) {
+        for (int i = 0; i < HalfSize; ++i) {
+            int value = input[i];
+            for (int r = 0; r < addedCount; ++r) {
+                value += added[r][i];
+            }
+            for (int r = 0; r < removedCount; ++r) {
+                value -= removed[r][i];
+            }
+            // Wraps like the 16-bit vector lanes do.
+            output[i] = static_cast<std::int16_t>(value);
+        }
+    }
+
+    void hiddenLayerScalar(const std::int16_t* us, const std::int16_t* them, const std::int8_t* weights,
+                           const std::int32_t* biases, std::uint8_t* hidden) {
+        std::uint8_t input[2 * HalfSize];
+        for (int i = 0; i < HalfSize; ++i) {
+            input[i] = clipNeuron(us[i]);
+            input[HalfSize + i] = clipNeuron(them[i]);
+        }
+        for (int j = 0; j < HiddenSize; ++j) {
+            const std::int8_t* row = weights + j * 2 * HalfSize;
+            int sum = biases[j];
+            for (int i = 0; i < 2 * HalfSize; ++i) {
+                sum += input[i] * row[i];
+            }
+            hidden[j] = clipNeuron(sum >> HiddenShift);
+        }
+    }
+
+#ifdef CHESS_HAS_X86_SIMD
+    // The vector kernels multiply unsigned inputs of at most 127 by signed
+    // weights in pairs (maddubs); two such products always fit in int16,
+    // so nothing saturates and the sums match the scalar kernel exactly.
+
+    CHESS_TARGET("sse4.1")
+    void updateRowsSse41(const std::int16_t* input, std::int16_t* output, const std::int16_t* const* added,
+                         int addedCount, const std::int16_t* const* removed, int removedCount) {
+        for (int i = 0; i < HalfSize; i += 8) {
+            __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+            for (int r = 0; r < addedCount; ++r) {
+                value = _mm_add_epi16(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(added[r] + i)));
+            }
+            for (int r = 0; r < removedCount; ++r) {
+                value = _mm_sub_epi16(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(removed[r] + i)));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), value);
+        }
+    }
+
+    CHESS_TARGET("sse4.1")
+    void hiddenLayerSse41(const std::int16_t* us, const std::int16_t* them, const std::int8_t* weights,
+                          const std::int32_t* biases, std::uint8_t* hidden) {
+        alignas(16) std::uint8_t input[2 * HalfSize];
+        const __m128i maxNeuron = _mm_set1_epi8(127);
+        const std::int16_t* halves[2] = { us, them };
+        for (int h = 0; h < 2; ++h) {
+            for (int i = 0; i < HalfSize; i += 16) {
+                __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(halves[h] + i));
+                __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(halves[h] + i + 8));
+                __m128i packed = _mm_min_epu8(_mm_packus_epi16(low, high), maxNeuron);
+                _mm_store_si128(reinterpret_cast<__m128i*>(input + h * HalfSize + i), packed);
+            }
+        }
+
+        const __m128i ones = _mm_set1_epi16(1);
+        for (int j = 0; j < HiddenSize; ++j) {
+            const std::int8_t* row = weights + j * 2 * HalfSize;
+            __m128i sum = _mm_setzero_si128();
+            for (int i = 0; i < 2 * HalfSize; i += 16) {
+                __m128i x = _mm_load_si128(reinterpret_cast<const __m128i*>(input + i));
+                __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+                sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_maddubs_epi16(x, w), ones));
+            }
+            sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+            sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+            hidden[j] = clipNeuron((_mm_cvtsi128_si32(sum) + biases[j]) >> HiddenShift);
+        }
+    }
+
+    CHESS_TARGET("avx2")
+    void updateRowsAvx2(const std::int16_t* input, std::int16_t* output, const std::int16_t* const* added,
+                        int addedCount, const std::int16_t* const* removed, int removedCount) {
+        for (int i = 0; i < HalfSize; i += 16) {
+            __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+            for (int r = 0; r < addedCount; ++r) {
+                value = _mm256_add_epi16(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(added[r] + i)));
+            }
+            for (int r = 0; r < removedCount; ++r) {
+                value = _mm256_sub_epi16(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(removed[r] + i)));
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), value);
+        }
+    }
+
+    CHESS_TARGET("avx2")
+    void hiddenLayerAvx2(const std::int16_t* us, const std::int16_t* them, const std::int8_t* weights,
+                         const std::int32_t* biases, std::uint8_t* hidden) {
+        alignas(32) std::uint8_t input[2 * HalfSize];
+        const __m256i maxNeuron = _mm256_set1_epi8(127);
+        const std::int16_t* halves[2] = { us, them };
+        for (int h = 0; h < 2; ++h) {
+            for (int i = 0; i < HalfSize; i += 32) {
+                __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(halves[h] + i));
+                __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(halves[h] + i + 16));
+                // packus works within 128-bit lanes; the permute restores
+                // the order of the inputs.
+                __m256i packed = _mm256_min_epu8(_mm256_packus_epi16(low, high), maxNeuron);
+                packed = _mm256_permute4x64_epi64(packed, 0xD8);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(input + h * HalfSize + i), packed);
+            }
+        }
+
+        const __m256i ones = _mm256_set1_epi16(1);
+        for (int j = 0; j < HiddenSize; ++j) {
+            const std::int8_t* row = weights + j * 2 * HalfSize;
+            __m256i sum = _mm256_setzero_si256();
+            for (int i = 0; i < 2 * HalfSize; i += 32) {
+                __m256i x = _mm256_load_si256(reinterpret_cast<const __m256i*>(input + i));
+                __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i));
+                sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_maddubs_epi16(x, w), ones));
+            }
+            __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+            half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+            half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xB1));
+            hidden[j] = clipNeuron((_mm_cvtsi128_si32(half) + biases[j]) >> HiddenShift);
+        }
+    }
+
+    bool cpuHas(Kernel kernel) {
+#if defined(_MSC_VER)
+        int regs[4];
+        __cpuid(regs, 1);
+        bool sse41 = (regs[2] & (1 << 19)) != 0;
+        // AVX2 also needs the operating system to save the YMM registers.
+        bool osSavesYmm = (regs[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
+        __cpuidex(regs, 7, 0);
+        bool avx2 = osSavesYmm && (regs[1] & (1 << 5)) != 0;
+#else
+        bool sse41 = __builtin_cpu_supports("sse4.1");
+        bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+        return kernel == Kernel::Scalar || (kernel == Kernel::Sse41 && sse41) || (kernel == Kernel::Avx2 && avx2);
+    }
+#else
+    bool cpuHas(Kernel kernel) {
+        return kernel == Kernel::Scalar;
+    }
+#endif
+
+    struct KernelFunctions {
+        UpdateRows updateRows;
+        HiddenLayer hiddenLayer;
+    };
+
+    KernelFunctions functionsFor(Kernel kernel) {
+#ifdef CHESS_HAS_X86_SIMD
+        if (kernel == Kernel::Avx2) {
+            return { updateRowsAvx2, hiddenLayerAvx2 };
+        }
+        if (kernel == Kernel::Sse41) {
+            return { updateRowsSse41, hiddenLayerSse41 };
+        }
+#endif
+        return { updateRowsScalar, hiddenLayerScalar };
+    }
+
+    int featureIndex(Color perspective, Piece piece, int square) {
+        int side = (colorOf(piece) == perspective) ? 0 : Features / 2;
+        if (perspective == Color::Black) {
+            square ^= 56;
+        }
+        return side + typeIndex(typeOf(piece)) * 64 + square;
+    }
+
+    std::uint32_t readUint32(const unsigned char* bytes) {
+        std::uint32_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+}
+
+Nnue::Kernel Nnue::bestKernel() {
+    if (cpuHas(Kernel::Avx2)) {
+        return Kernel::Avx2;
+    }
+    return cpuHas(Kernel::Sse41) ? Kernel::Sse41 : Kernel::Scalar;
+}
+
+bool Nnue::isSupported(Kernel kernel) {
+    return cpuHas(kernel);
+}
+
+const char* Nnue::kernelName(Kernel kernel) {
+    switch (kernel) {
+    case Kernel::Avx2: return "AVX2";
+    case Kernel::Sse41: return "SSE4.1";
+    default: return "scalar";
+    }
+}
+
+Nnue::DirtyPieces Nnue::changesOf(const Position& position, const Move& move) {
+    DirtyPieces changes{};
+    int from = move.from();
+    int to = move.to();
+    Piece piece = position.pieceOn(from);
+    Color us = colorOf(piece);
+
+    if (move.type() == Move::Castling) {
+        bool kingSide = to > from;
+        Piece rook = makePiece(us, PieceType::Rook);
+        changes.removedCount = changes.addedCount = 2;
+        changes.removed[0] = changes.added[0] = piece;
+        changes.removedSquares[0] = static_cast<std::int8_t>(from);
+        changes.addedSquares[0] = static_cast<std::int8_t>(to);
+        changes.removed[1] = changes.added[1] = rook;
+        changes.removedSquares[1] = static_cast<std::int8_t>(kingSide ? to + 1 : to - 2);
+        changes.addedSquares[1] = static_cast<std::int8_t>(kingSide ? to - 1 : to + 1);
+        return changes;
+    }
+
+    changes.removed[0] = piece;
+    changes.removedSquares[0] = static_cast<std::int8_t>(from);
+    changes.removedCount = 1;
+    if (move.type() == Move::EnPassant) {
+        changes.removed[1] = makePiece(opposite(us), PieceType::Pawn);
+        changes.removedSquares[1] = static_cast<std::int8_t>(to - ((us == Color::White) ? 8 : -8));
+        changes.removedCount = 2;
+    }
+    else if (!position.isEmpty(to)) {
+        changes.removed[1] = position.pieceOn(to);
+        changes.removedSquares[1] = static_cast<std::int8_t>(to);
+        changes.removedCount = 2;
+    }
+    changes.added[0] = (move.type() == Move::Promotion) ? makePiece(us, move.promotion()) : piece;
+    changes.addedSquares[0] = static_cast<std::int8_t>(to);
+    changes.addedCount = 1;
+    return changes;
+}
+
+Nnue::Network::Network()
+    : activeKernel(bestKernel()), featureBiases(nullptr), featureWeights(nullptr), hiddenBiases(nullptr),
+      hiddenWeights(nullptr), outputBias(nullptr), outputWeights(nullptr) {
+}
+
+bool Nnue::Network::load(const std::string& path) {
+    MappedFile candidate;
+    if (!candidate.open(path)) {
+        return false;
+    }
+    const unsigned char* data = candidate.data();
+    if (candidate.size() != FileSize || std::memcmp(data, Magic, sizeof(Magic)) != 0 ||
+        readUint32(data + 4) != Version || readUint32(data + 8) != HalfSize || readUint32(data + 12) != HiddenSize) {
+        std::cerr << path << " is not a " << Features << "x" << HalfSize << "x2-" << HiddenSize
+                  << "-1 network (version " << Version << ", " << FileSize << " bytes).\n";
+        return false;
+    }
+
+    file.swap(candidate);
+    filePath = path;
+    featureBiases = reinterpret_cast<const std::int16_t*>(data + FeatureBiasesOffset);
+    featureWeights = reinterpret_cast<const std::int16_t*>(data + FeatureWeightsOffset);
+    hiddenBiases = reinterpret_cast<const std::int32_t*>(data + HiddenBiasesOffset);
+    hiddenWeights = reinterpret_cast<const std::int8_t*>(data + HiddenWeightsOffset);
+    outputBias = reinterpret_cast<const std::int32_t*>(data + OutputBiasOffset);
+    outputWeights = reinterpret_cast<const std::int8_t*>(data + OutputWeightsOffset);
+    return true;
+}
+
+void Nnue::Network::unload() {
+    file.close();
+    filePath.clear();
+}
+
+void Nnue::Network::setKernel(Kernel kernel) {
+    if (isSupported(kernel)) {
+        activeKernel = kernel;
+    }
+}
+
+void Nnue::Network::refresh(const Position& position, Accumulator& accumulator) const {
+    UpdateRows updateRows = functionsFor(activeKernel).updateRows;
+    for (Color perspective : { Color::White, Color::Black }) {
+        const std::int16_t* rows[MaxRows];
+        int count = 0;
+        Bitboard pieces = position.occupied();
+        while (pieces) {
+            int square = popLsb(pieces);
+            rows[count++] = featureWeights + featureIndex(perspective, position.pieceOn(square), square) * HalfSize;
+        }
+        updateRows(featureBiases, accumulator.values[colorIndex(perspective)], rows, count, nullptr, 0);
+    }
+}
+
+void Nnue::Network::update(const Accumulator& before, const DirtyPieces& changes, Accumulator& after) const {
+    UpdateRows updateRows = functionsFor(activeKernel).updateRows;
+    for (Color perspective : { Color::White, Color::Black }) {
+        const std::int16_t* added[2];
+        const std::int16_t* removed[2];
+        for (int i = 0; i < changes.addedCount; ++i) {
+            added[i] = featureWeights + featureIndex(perspective, changes.added[i], changes.addedSquares[i]) * HalfSize;
+        }
+        for (int i = 0; i < changes.removedCount; ++i) {
+            removed[i] = featureWeights
+                + featureIndex(perspective, changes.removed[i], changes.removedSquares[i]) * HalfSize;
+        }
+        int index = colorIndex(perspective);
+        updateRows(before.values[index], after.values[index], added, changes.addedCount, removed,
+                   changes.removedCount);
+    }
+}
+
+int Nnue::Network::evaluate(const Accumulator& accumulator, Color side) const {
+    std::uint8_t hidden[HiddenSize];
+    functionsFor(activeKernel).hiddenLayer(accumulator.values[colorIndex(side)],
+                                           accumulator.values[colorIndex(opposite(side))], hiddenWeights,
+                                           hiddenBiases, hidden);
+    int sum = *outputBias;
+    for (int j = 0; j < HiddenSize; ++j) {
+        sum += hidden[j] * outputWeights[j];
+    }
+    return std::clamp(sum / OutputScale, -MaxScore, MaxScore);
+}
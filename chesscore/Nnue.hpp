@@ -0,0 +1,106 @@
+#ifndef NNUE_HPP
+#define NNUE_HPP
+
+#include <cstdint>
+#include <string>
+#include "MappedFile.hpp"
+#include "Move.hpp"
+#include "Position.hpp"
+
+// Efficiently updatable neural network evaluation. The first layer turns
+// the 768 piece-square features (color x piece type x square) into 256
+// neurons for each side's point of view; a move changes at most four
+// features, so the search keeps these accumulators up to date by adding
+// and subtracting weight rows instead of recomputing them. The two halves,
+// side to move first, clipped to 0..127, feed a 512 -> 32 -> 1 network in
+// int8 arithmetic.
+//
+// The network file is a 64-byte header (the bytes "CHNN", then version,
+// accumulator size and hidden size as uint32), followed by, little-endian:
+//   int16 feature biases[256]
+//   int16 feature weights[768][256]
+//   int32 hidden biases[32]
+//   int8  hidden weights[32][512]
+//   int32 output bias
+//   int8  output weights[32]
+// Feature index, seen from White: (friendly ? 0 : 384) + type * 64 + square.
+// Black's view mirrors the board vertically. A hidden neuron is its sum
+// shifted right by HiddenShift and clipped to 0..127; the output divided by
+// OutputScale is the score in centipawns for the side to move.
+//
+// The weights are used straight from the mapped file, so engines loading
+// the same network share its pages.
+namespace Nnue {
+    constexpr int Features = 768;
+    constexpr int HalfSize = 256;
+    constexpr int HiddenSize = 32;
+    constexpr int HiddenShift = 6;
+    constexpr int OutputScale = 16;
+    // Scores stay well clear of mate scores whatever the network says.
+    constexpr int MaxScore = 20000;
+
+    // Implementations of the inner loops. All give identical results;
+    // Scalar is the reference the others are checked against.
+    enum class Kernel { Scalar, Sse41, Avx2 };
+
+    // The fastest kernel this CPU supports.
+    Kernel bestKernel();
+    bool isSupported(Kernel kernel);
+    const char* kernelName(Kernel kernel);
+
+    // The pieces a move takes off the board and puts on it: at most two of
+    // each (a capture, en passant, a capturing promotion or castling).
+    struct DirtyPieces {
+        int removedCount;
+        int addedCount;
+        Piece removed[2];
+        std::int8_t removedSquares[2];
+        Piece added[2];
+        std::int8_t addedSquares[2];
+    };
+
+    // What `move` changes, for the position before it is played.
+    DirtyPieces changesOf(const Position& position, const Move& move);
+
+    // The first layer for both points of view, indexed by colorIndex.
+    struct alignas(64) Accumulator {
+        std::int16_t values[2][HalfSize];
+    };
+
+    class Network {
+    public:
+        Network();
+
+        // Maps the network file. Reports to std::cerr and returns false,
+        // keeping the previous network, if the file is missing or is not
+        // a network of this shape.
+        bool load(const std::string& path);
+        void unload();
+        bool isLoaded() const { return file.isOpen(); }
+        const std::string& path() const { return filePath; }
+
+        // Defaults to bestKernel(); an unsupported kernel is ignored.
+        void setKernel(Kernel kernel);
+        Kernel kernel() const { return activeKernel; }
+
+        // Computes the accumulator from scratch.
+        void refresh(const Position& position, Accumulator& accumulator) const;
+        // The accumulator after a move, from the one before it.
+        void update(const Accumulator& before, const DirtyPieces& changes, Accumulator& after) const;
+        // Score in centipawns from `side`'s point of view, `side` to move.
+        int evaluate(const Accumulator& accumulator, Color side) const;
+
+    private:
+        MappedFile file;
+        std::string filePath;
+        Kernel activeKernel;
+        const std::int16_t* featureBiases;
+        const std::int16_t* featureWeights;
+        const std::int32_t* hiddenBiases;
+        const std::int8_t* hiddenWeights;
+        const std::int32_t* outputBias;
+        const std::int8_t* outputWeights;
+    };
+}
+
+#endif // NNUE_HPP
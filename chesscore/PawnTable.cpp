@@ -0,0 +1,40 @@
+#include "PawnTable.hpp"
+#include <algorithm>
+#include <iostream>
+#include <new>
+
+PawnTable::PawnTable() : entryCount(0), probeCount(0), hitCount(0) {
+    resize(DefaultSizeMB);
+}
+
+bool PawnTable::resize(std::size_t megabytes) {
+    std::size_t wanted = std::max<std::size_t>(megabytes, 1) * 1024 * 1024 / sizeof(Entry);
+    std::size_t count = 1;
+    while (count * 2 <= wanted) {
+        count *= 2;
+    }
+
+    Entry* memory = new (std::nothrow) Entry[count];
+    if (!memory) {
+        std::cerr << "Failed to allocate a " << megabytes << " MB pawn hash table.\n";
+        return false;
+    }
+    entries.reset(memory);
+    entryCount = count;
+    clear();
+    return true;
+}
+
+std::size_t PawnTable::sizeMB() const {
+    return entryCount * sizeof(Entry) / (1024 * 1024);
+}
+
+void PawnTable::clear() {
+    std::fill(entries.get(), entries.get() + entryCount, Entry{});
+    resetStats();
+}
+
+void PawnTable::resetStats() {
+    probeCount = 0;
+    hitCount = 0;
+}
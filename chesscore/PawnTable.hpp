@@ -0,0 +1,64 @@
+#ifndef PAWNTABLE_HPP
+#define PAWNTABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "Bitboard.hpp"
+#include "Psqt.hpp"
+#include "Zobrist.hpp"
+
+// Pawn-structure evaluations keyed by the pawn-only Zobrist key. Pawns move
+// rarely, so most nodes find their structure already scored. Each search
+// thread owns one table, which needs no locking; entries stay valid from
+// one search to the next.
+//
+// Direct-mapped and always-replace. An empty slot has key 0, which is also
+// the key of a board without pawns; its zero score and empty passed-pawn
+// sets are exactly that board's evaluation.
+class PawnTable {
+public:
+    static constexpr std::size_t DefaultSizeMB = 1;
+
+    struct Entry {
+        Zobrist::Key key;
+        // Doubled, isolated, backward and passed pawns, from White's point
+        // of view.
+        Score score;
+        // Passed pawns of each color, indexed by colorIndex.
+        Bitboard passed[2];
+    };
+
+    PawnTable();
+    PawnTable(const PawnTable&) = delete;
+    PawnTable& operator=(const PawnTable&) = delete;
+
+    // Reallocates to the largest power-of-two number of entries that fits
+    // in `megabytes` and clears it. Keeps the old table if allocation fails.
+    bool resize(std::size_t megabytes);
+    std::size_t sizeMB() const;
+    void clear();
+
+    // The slot for `key`. `found` tells whether it already holds that
+    // key's structure; if not, the caller fills it in.
+    Entry& probe(Zobrist::Key key, bool& found) {
+        Entry& entry = entries[key & (entryCount - 1)];
+        found = entry.key == key;
+        ++probeCount;
+        hitCount += found;
+        return entry;
+    }
+
+    // Probes and hits since the last resetStats().
+    std::uint64_t probes() const { return probeCount; }
+    std::uint64_t hits() const { return hitCount; }
+    void resetStats();
+
+private:
+    std::unique_ptr<Entry[]> entries;
+    std::size_t entryCount;
+    std::uint64_t probeCount;
+    std::uint64_t hitCount;
+};
+
+#endif // PAWNTABLE_HPP
@@ -0,0 +1,57 @@
+#include "Perft.hpp"
+#include "MoveGen.hpp"
+
+// Counts from the Chess Programming Wiki "Perft Results" page.
+const PerftPosition PerftSuite[] = {
+    { "startpos", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+      { 20, 400, 8902, 197281, 4865609, 119060324 } },
+    { "kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+      { 48, 2039, 97862, 4085603, 193690690, 0 } },
+    { "position3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+      { 14, 191, 2812, 43238, 674624, 11030083 } },
+    { "position4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+      { 6, 264, 9467, 422333, 15833292, 0 } },
+    { "position4-mirrored", "r2q1rk1/pP1p2pp/Q4n2/bbp1p3/Np6/1B3NBn/pPPP1PPP/R3K2R b KQ - 0 1",
+      { 6, 264, 9467, 422333, 15833292, 0 } },
+    { "position5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+      { 44, 1486, 62379, 2103487, 89941194, 0 } },
+};
+
+const int PerftSuiteSize = sizeof(PerftSuite) / sizeof(PerftSuite[0]);
+
+std::uint64_t perft(Position& position, int depth) {
+    if (depth == 0) {
+        return 1;
+    }
+    MoveList moves;
+    generateLegalMoves(position, moves);
+    if (depth == 1) {
+        return moves.size();
+    }
+
+    std::uint64_t nodes = 0;
+    for (const Move& move : moves) {
+        position.makeMove(move);
+        nodes += perft(position, depth - 1);
+        position.unmakeMove(move);
+    }
+    return nodes;
+}
+
+std::uint64_t perftDivide(Position& position, int depth, std::ostream& out) {
+    if (depth <= 0) {
+        return 1;
+    }
+    MoveList moves;
+    generateLegalMoves(position, moves);
+
+    std::uint64_t total = 0;
+    for (const Move& move : moves) {
+        position.makeMove(move);
+        std::uint64_t nodes = perft(position, depth - 1);
+        position.unmakeMove(move);
+        out << toUci(move) << ": " << nodes << '\n';
+        total += nodes;
+    }
+    return total;
+}
@@ -0,0 +1,25 @@
+#ifndef PERFT_HPP
+#define PERFT_HPP
+
+#include <cstdint>
+#include <ostream>
+#include "Position.hpp"
+
+// Reference position with known leaf counts; nodes[d - 1] is the count at
+// depth d, 0 where the suite does not list one.
+struct PerftPosition {
+    const char* name;
+    const char* fen;
+    std::uint64_t nodes[6];
+};
+
+extern const PerftPosition PerftSuite[];
+extern const int PerftSuiteSize;
+
+// Number of leaf nodes of the legal move tree below `position`.
+std::uint64_t perft(Position& position, int depth);
+
+// Same as perft, but prints the subtree size of every root move.
+std::uint64_t perftDivide(Position& position, int depth, std::ostream& out);
+
+#endif // PERFT_HPP
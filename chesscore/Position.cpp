@@ -0,0 +1,546 @@
+#include "Position.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+static_assert(sizeof(Position::UndoInfo) == 16, "Undo records should stay compact");
+
+const char* const StartFen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+namespace {
+    const char PieceChars[] = "PNBRQK";
+
+    constexpr int A1 = 0, B1 = 1, C1 = 2, D1 = 3, E1 = 4, F1 = 5, G1 = 6, H1 = 7;
+    constexpr int A8 = 56, B8 = 57, C8 = 58, D8 = 59, E8 = 60, F8 = 61, G8 = 62, H8 = 63;
+
+    // Piece counts a game can reach: at most 16 men and 8 pawns per side,
+    // and no more extra pieces than pawns have gone missing to promote.
+    bool hasReachableMaterial(const Position& position, Color color) {
+        int pawns = popCount(position.pieces(color, PieceType::Pawn));
+        int promoted = std::max(popCount(position.pieces(color, PieceType::Knight)) - 2, 0)
+            + std::max(popCount(position.pieces(color, PieceType::Bishop)) - 2, 0)
+            + std::max(popCount(position.pieces(color, PieceType::Rook)) - 2, 0)
+            + std::max(popCount(position.pieces(color, PieceType::Queen)) - 1, 0);
+        return popCount(position.pieces(color)) <= 16 && pawns <= 8 && promoted <= 8 - pawns;
+    }
+
+    // Rights that survive a move touching the given square.
+    std::uint8_t castlingMask(int square) {
+        switch (square) {
+        case A1: return Position::AllCastling & ~Position::WhiteQueenSide;
+        case E1: return Position::AllCastling & ~(Position::WhiteKingSide | Position::WhiteQueenSide);
+        case H1: return Position::AllCastling & ~Position::WhiteKingSide;
+        case A8: return Position::AllCastling & ~Position::BlackQueenSide;
+        case E8: return Position::AllCastling & ~(Position::BlackKingSide | Position::BlackQueenSide);
+        case H8: return Position::AllCastling & ~Position::BlackKingSide;
+        default: return Position::AllCastling;
+        }
+    }
+}
+
+Position::Position() {
+    static_assert(offsetof(Position, undoStack) <= 128, "Board state should fit in two cache lines");
+    clear();
+}
+
+void Position::clear() {
+    for (auto& bb : byType) {
+        bb = 0;
+    }
+    byColor[0] = byColor[1] = 0;
+    constexpr int Empty = static_cast<int>(Piece::NoPiece);
+    std::memset(mailbox, Empty | (Empty << 4), sizeof(mailbox));
+    positionKey = 0;
+    pawnHashKey = 0;
+    psq = Score{};
+    gamePhase = 0;
+    side = Color::White;
+    castling = 0;
+    epSquare = NoSquare;
+    halfmoves = 0;
+    fullmoves = 1;
+    undoCount = 0;
+}
+
+void Position::setStartPosition() {
+    setFen(StartFen);
+}
+
+bool Position::setFen(const std::string& fen) {
+    clear();
+    std::istringstream stream(fen);
+    std::string board, sideText, castlingText, epText;
+    int halfmoveValue = 0, fullmoveValue = 1;
+    if (!(stream >> board >> sideText)) {
+        return false;
+    }
+    stream >> castlingText >> epText;
+    if (stream >> halfmoveValue) {
+        stream >> fullmoveValue;
+    }
+
+    int file = 0, rank = 7;
+    for (char c : board) {
+        if (c == '/') {
+            if (file != 8 || rank == 0) {
+                clear();
+                return false;
+            }
+            file = 0;
+            --rank;
+        }
+        else if (c >= '1' && c <= '8') {
+            file += c - '0';
+        }
+        else {
+            char upper = (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+            const char* found = std::strchr(PieceChars, upper);
+            if (!found || file > 7) {
+                clear();
+                return false;
+            }
+            Color color = (c >= 'a') ? Color::Black : Color::White;
+            putPiece(color, static_cast<PieceType>(found - PieceChars), makeSquare(file, rank));
+            ++file;
+        }
+        if (file > 8) {
+            clear();
+            return false;
+        }
+    }
+    if (rank != 0 || file != 8 || popCount(pieces(Color::White, PieceType::King)) != 1 ||
+        popCount(pieces(Color::Black, PieceType::King)) != 1 ||
+        !hasReachableMaterial(*this, Color::White) || !hasReachableMaterial(*this, Color::Black) ||
+        (pieces(PieceType::Pawn) & (Rank1BB | Rank8BB))) {
+        clear();
+        return false;
+    }
+
+    if (sideText != "w" && sideText != "b") {
+        clear();
+        return false;
+    }
+    side = (sideText == "w") ? Color::White : Color::Black;
+    // The side that just moved cannot have left its king in check.
+    if (isInCheck(opposite(side))) {
+        clear();
+        return false;
+    }
+
+    // Each right needs its king and rook still on their starting squares.
+    for (char c : castlingText) {
+        switch (c) {
+        case 'K': castling |= WhiteKingSide; break;
+        case 'Q': castling |= WhiteQueenSide; break;
+        case 'k': castling |= BlackKingSide; break;
+        case 'q': castling |= BlackQueenSide; break;
+        case '-': break;
+        default:
+            clear();
+            return false;
+        }
+    }
+    const struct { CastlingRight right; int king; int rook; Color color; } castlingSquares[] = {
+        { WhiteKingSide, E1, H1, Color::White }, { WhiteQueenSide, E1, A1, Color::White },
+        { BlackKingSide, E8, H8, Color::Black }, { BlackQueenSide, E8, A8, Color::Black },
+    };
+    for (const auto& entry : castlingSquares) {
+        if ((castling & entry.right) && (pieceOn(entry.king) != makePiece(entry.color, PieceType::King) ||
+                                         pieceOn(entry.rook) != makePiece(entry.color, PieceType::Rook))) {
+            clear();
+            return false;
+        }
+    }
+
+    // An en passant square lies behind a pawn that just made a double
+    // push, on a square it passed over.
+    if (!epText.empty() && epText != "-") {
+        char epRank = (side == Color::White) ? '6' : '3';
+        if (epText.size() != 2 || epText[0] < 'a' || epText[0] > 'h' || epText[1] != epRank) {
+            clear();
+            return false;
+        }
+        int square = makeSquare(epText[0] - 'a', epText[1] - '1');
+        int forward = (side == Color::White) ? -8 : 8;
+        if (pieceOn(square + forward) != makePiece(opposite(side), PieceType::Pawn) || !isEmpty(square) ||
+            !isEmpty(square - forward)) {
+            clear();
+            return false;
+        }
+        epSquare = static_cast<std::int8_t>(square);
+    }
+    // Counters must fit their fields; the fullmove number starts at 1.
+    if (halfmoveValue < 0 || halfmoveValue > std::numeric_limits<decltype(halfmoves)>::max() ||
+        fullmoveValue < 1 || fullmoveValue > std::numeric_limits<decltype(fullmoves)>::max()) {
+        clear();
+        return false;
+    }
+    halfmoves = static_cast<decltype(halfmoves)>(halfmoveValue);
+    fullmoves = static_cast<decltype(fullmoves)>(fullmoveValue);
+    positionKey = computeKey();
+    return true;
+}
+
+std::string Position::fen() const {
+    std::string result;
+    for (int rank = 7; rank >= 0; --rank) {
+        int empty = 0;
+        for (int file = 0; file < 8; ++file) {
+            int square = makeSquare(file, rank);
+            PieceType type = pieceTypeOn(square);
+            if (type == PieceType::None) {
+                ++empty;
+                continue;
+            }
+            if (empty) {
+                result += static_cast<char>('0' + empty);
+                empty = 0;
+            }
+            char c = PieceChars[typeIndex(type)];
+            result += (colorOn(square) == Color::White) ? c : static_cast<char>(c - 'A' + 'a');
+        }
+        if (empty) {
+            result += static_cast<char>('0' + empty);
+        }
+        if (rank > 0) {
+            result += '/';
+        }
+    }
+
+    result += (side == Color::White) ? " w " : " b ";
+    if (castling == 0) {
+        result += '-';
+    }
+    if (castling & WhiteKingSide) result += 'K';
+    if (castling & WhiteQueenSide) result += 'Q';
+    if (castling & BlackKingSide) result += 'k';
+    if (castling & BlackQueenSide) result += 'q';
+
+    result += ' ';
+    if (epSquare == NoSquare) {
+        result += '-';
+    }
+    else {
+        result += static_cast<char>('a' + fileOf(epSquare));
+        result += static_cast<char>('1' + rankOf(epSquare));
+    }
+    result += ' ' + std::to_string(halfmoves) + ' ' + std::to_string(fullmoves);
+    return result;
+}
+
+Zobrist::Key Position::computeKey() const {
+    Zobrist::Key result = 0;
+    for (int c = 0; c < 2; ++c) {
+        for (int t = 0; t < 6; ++t) {
+            Bitboard bb = pieces(static_cast<Color>(c), static_cast<PieceType>(t));
+            while (bb) {
+                result ^= Zobrist::keys.pieceSquare[c][t][popLsb(bb)];
+            }
+        }
+    }
+    result ^= Zobrist::keys.castling[castling] ^ enPassantKey();
+    if (side == Color::Black) {
+        result ^= Zobrist::keys.blackToMove;
+    }
+    return result;
+}
+
+Score Position::computePsqScore() const {
+    Score result{};
+    for (int square = 0; square < 64; ++square) {
+        Piece piece = pieceOn(square);
+        if (piece != Piece::NoPiece) {
+            result += Psqt::piece(colorOf(piece), typeOf(piece), square);
+        }
+    }
+    return result;
+}
+
+Zobrist::Key Position::enPassantKey() const {
+    if (epSquare == NoSquare ||
+        !(Bitboards::pawnAttacks(opposite(side), epSquare) & pieces(side, PieceType::Pawn))) {
+        return 0;
+    }
+    return Zobrist::keys.enPassantFile[fileOf(epSquare)];
+}
+
+bool Position::isRepetition() const {
+    // Only positions with the same side to move can repeat, and nothing
+    // before the last irreversible move can.
+    int end = std::min<int>(halfmoves, undoCount);
+    for (int i = 4; i <= end; i += 2) {
+        if (undoStack[undoCount - i].key == positionKey) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Position::trimHistory() {
+    int keep = std::min({ static_cast<int>(halfmoves), static_cast<int>(undoCount), MaxGamePly / 2 });
+    std::copy(undoStack + undoCount - keep, undoStack + undoCount, undoStack);
+    undoCount = static_cast<std::uint16_t>(keep);
+}
+
+Bitboard Position::attackersTo(int square, Bitboard occupied) const {
+    using namespace Bitboards;
+    Bitboard queens = pieces(PieceType::Queen);
+    return (pawnAttacks(Color::Black, square) & pieces(Color::White, PieceType::Pawn))
+        | (pawnAttacks(Color::White, square) & pieces(Color::Black, PieceType::Pawn))
+        | (knightAttacks(square) & pieces(PieceType::Knight))
+        | (kingAttacks(square) & pieces(PieceType::King))
+        | (bishopAttacks(square, occupied) & (pieces(PieceType::Bishop) | queens))
+        | (rookAttacks(square, occupied) & (pieces(PieceType::Rook) | queens));
+}
+
+bool Position::isSquareAttacked(int square, Color by) const {
+    return isSquareAttacked(square, by, occupied());
+}
+
+bool Position::isSquareAttacked(int square, Color by, Bitboard occupied) const {
+    using namespace Bitboards;
+    if (pawnAttacks(opposite(by), square) & pieces(by, PieceType::Pawn)) return true;
+    if (knightAttacks(square) & pieces(by, PieceType::Knight)) return true;
+    if (kingAttacks(square) & pieces(by, PieceType::King)) return true;
+    Bitboard queens = pieces(by, PieceType::Queen);
+    if (bishopAttacks(square, occupied) & (pieces(by, PieceType::Bishop) | queens)) return true;
+    if (rookAttacks(square, occupied) & (pieces(by, PieceType::Rook) | queens)) return true;
+    return false;
+}
+
+Bitboard Position::attacksBy(Color by, Bitboard occupied) const {
+    using namespace Bitboards;
+    Bitboard attacks = pawnAttacks(by, pieces(by, PieceType::Pawn))
+        | kingAttacks(lsb(pieces(by, PieceType::King)));
+    Bitboard knights = pieces(by, PieceType::Knight);
+    while (knights) {
+        attacks |= knightAttacks(popLsb(knights));
+    }
+    Bitboard queens = pieces(by, PieceType::Queen);
+    Bitboard diagonal = pieces(by, PieceType::Bishop) | queens;
+    while (diagonal) {
+        attacks |= bishopAttacks(popLsb(diagonal), occupied);
+    }
+    Bitboard straight = pieces(by, PieceType::Rook) | queens;
+    while (straight) {
+        attacks |= rookAttacks(popLsb(straight), occupied);
+    }
+    return attacks;
+}
+
+Bitboard Position::checkers() const {
+    return attackersTo(kingSquare(side), occupied()) & pieces(opposite(side));
+}
+
+bool Position::isInCheck(Color color) const {
+    return isSquareAttacked(kingSquare(color), opposite(color));
+}
+
+bool Position::isPromotion(int from, int to) const {
+    return pieceTypeOn(from) == PieceType::Pawn && (rankOf(to) == 0 || rankOf(to) == 7);
+}
+
+Bitboard Position::castlingTargets() const {
+    // Most positions have no castling path clear; skip the attack map then.
+    Bitboard occupancy = occupied();
+    bool pathClear = side == Color::White
+        ? ((castling & WhiteKingSide) && !(occupancy & (squareBB(F1) | squareBB(G1)))) ||
+          ((castling & WhiteQueenSide) && !(occupancy & (squareBB(B1) | squareBB(C1) | squareBB(D1))))
+        : ((castling & BlackKingSide) && !(occupancy & (squareBB(F8) | squareBB(G8)))) ||
+          ((castling & BlackQueenSide) && !(occupancy & (squareBB(B8) | squareBB(C8) | squareBB(D8))));
+    return pathClear ? castlingTargets(attacksBy(opposite(side), occupancy)) : 0;
+}
+
+Bitboard Position::castlingTargets(Bitboard attacked) const {
+    Bitboard occupancy = occupied();
+    Bitboard targets = 0;
+    if (side == Color::White) {
+        if ((castling & WhiteKingSide) && !(occupancy & (squareBB(F1) | squareBB(G1))) &&
+            !(attacked & (squareBB(E1) | squareBB(F1) | squareBB(G1)))) {
+            targets |= squareBB(G1);
+        }
+        if ((castling & WhiteQueenSide) && !(occupancy & (squareBB(B1) | squareBB(C1) | squareBB(D1))) &&
+            !(attacked & (squareBB(E1) | squareBB(D1) | squareBB(C1)))) {
+            targets |= squareBB(C1);
+        }
+    }
+    else {
+        if ((castling & BlackKingSide) && !(occupancy & (squareBB(F8) | squareBB(G8))) &&
+            !(attacked & (squareBB(E8) | squareBB(F8) | squareBB(G8)))) {
+            targets |= squareBB(G8);
+        }
+        if ((castling & BlackQueenSide) && !(occupancy & (squareBB(B8) | squareBB(C8) | squareBB(D8))) &&
+            !(attacked & (squareBB(E8) | squareBB(D8) | squareBB(C8)))) {
+            targets |= squareBB(C8);
+        }
+    }
+    return targets;
+}
+
+void Position::makeMove(const Move& move) {
+    assert(undoCount < MaxGamePly);
+    int from = move.from();
+    int to = move.to();
+    Color us = side;
+    Color them = opposite(us);
+    PieceType type = pieceTypeOn(from);
+    PieceType captured = pieceTypeOn(to);
+    int forward = (us == Color::White) ? 8 : -8;
+    bool enPassant = move.type() == Move::EnPassant;
+
+    UndoInfo& undo = undoStack[undoCount++];
+    undo.key = positionKey;
+    undo.captured = enPassant ? PieceType::Pawn : captured;
+    undo.castling = castling;
+    undo.epSquare = epSquare;
+    undo.halfmoves = halfmoves;
+
+    positionKey ^= enPassantKey() ^ Zobrist::keys.castling[castling] ^ Zobrist::keys.blackToMove;
+    ++halfmoves;
+    epSquare = NoSquare;
+    if (captured != PieceType::None) {
+        removePiece(them, captured, to);
+        halfmoves = 0;
+    }
+
+    if (type == PieceType::Pawn) {
+        halfmoves = 0;
+        if (enPassant) {
+            removePiece(them, PieceType::Pawn, to - forward);
+        }
+        if (to - from == 2 * forward) {
+            epSquare = static_cast<std::int8_t>(from + forward);
+        }
+    }
+    else if (move.type() == Move::Castling) {
+        if (to > from) {
+            movePiece(us, PieceType::Rook, to + 1, to - 1);
+        }
+        else {
+            movePiece(us, PieceType::Rook, to - 2, to + 1);
+        }
+    }
+
+    if (move.type() == Move::Promotion) {
+        removePiece(us, PieceType::Pawn, from);
+        putPiece(us, move.promotion(), to);
+    }
+    else {
+        movePiece(us, type, from, to);
+    }
+
+    castling &= castlingMask(from) & castlingMask(to);
+    if (us == Color::Black) {
+        ++fullmoves;
+    }
+    side = them;
+    positionKey ^= Zobrist::keys.castling[castling] ^ enPassantKey();
+}
+
+void Position::unmakeMove(const Move& move) {
+    int from = move.from();
+    int to = move.to();
+    side = opposite(side);
+    Color us = side;
+    Color them = opposite(us);
+    const UndoInfo& undo = undoStack[--undoCount];
+
+    if (move.type() == Move::Promotion) {
+        removePiece(us, move.promotion(), to);
+        putPiece(us, PieceType::Pawn, from);
+    }
+    else {
+        movePiece(us, pieceTypeOn(to), to, from);
+    }
+
+    if (move.type() == Move::Castling) {
+        if (to > from) {
+            movePiece(us, PieceType::Rook, to - 1, to + 1);
+        }
+        else {
+            movePiece(us, PieceType::Rook, to + 1, to - 2);
+        }
+    }
+
+    if (undo.captured != PieceType::None) {
+        int captureSquare = to;
+        if (move.type() == Move::EnPassant) {
+            captureSquare = to - ((us == Color::White) ? 8 : -8);
+        }
+        putPiece(them, undo.captured, captureSquare);
+    }
+
+    castling = undo.castling;
+    epSquare = undo.epSquare;
+    halfmoves = undo.halfmoves;
+    positionKey = undo.key;
+    if (us == Color::Black) {
+        --fullmoves;
+    }
+}
+
+void Position::makeNullMove() {
+    assert(undoCount < MaxGamePly);
+    UndoInfo& undo = undoStack[undoCount++];
+    undo.key = positionKey;
+    undo.captured = PieceType::None;
+    undo.castling = castling;
+    undo.epSquare = epSquare;
+    undo.halfmoves = halfmoves;
+
+    positionKey ^= enPassantKey() ^ Zobrist::keys.blackToMove;
+    epSquare = NoSquare;
+    halfmoves = 0;
+    side = opposite(side);
+}
+
+void Position::unmakeNullMove() {
+    const UndoInfo& undo = undoStack[--undoCount];
+    side = opposite(side);
+    epSquare = undo.epSquare;
+    halfmoves = undo.halfmoves;
+    positionKey = undo.key;
+}
+
+void Position::putPiece(Color color, PieceType type, int square) {
+    Bitboard bb = squareBB(square);
+    byType[typeIndex(type)] |= bb;
+    byColor[colorIndex(color)] |= bb;
+    setPieceOn(square, makePiece(color, type));
+    positionKey ^= Zobrist::piece(color, type, square);
+    if (type == PieceType::Pawn) {
+        pawnHashKey ^= Zobrist::piece(color, type, square);
+    }
+    psq += Psqt::piece(color, type, square);
+    gamePhase += Psqt::PhaseWeights[typeIndex(type)];
+}
+
+void Position::removePiece(Color color, PieceType type, int square) {
+    Bitboard bb = ~squareBB(square);
+    byType[typeIndex(type)] &= bb;
+    byColor[colorIndex(color)] &= bb;
+    setPieceOn(square, Piece::NoPiece);
+    positionKey ^= Zobrist::piece(color, type, square);
+    if (type == PieceType::Pawn) {
+        pawnHashKey ^= Zobrist::piece(color, type, square);
+    }
+    psq -= Psqt::piece(color, type, square);
+    gamePhase -= Psqt::PhaseWeights[typeIndex(type)];
+}
+
+void Position::movePiece(Color color, PieceType type, int from, int to) {
+    Bitboard fromTo = squareBB(from) | squareBB(to);
+    byType[typeIndex(type)] ^= fromTo;
+    byColor[colorIndex(color)] ^= fromTo;
+    setPieceOn(from, Piece::NoPiece);
+    setPieceOn(to, makePiece(color, type));
+    Zobrist::Key moveKey = Zobrist::piece(color, type, from) ^ Zobrist::piece(color, type, to);
+    positionKey ^= moveKey;
+    if (type == PieceType::Pawn) {
+        pawnHashKey ^= moveKey;
+    }
+    psq += Psqt::piece(color, type, to) - Psqt::piece(color, type, from);
+}
@@ -0,0 +1,171 @@
+#ifndef POSITION_HPP
+#define POSITION_HPP
+
+#include <string>
+#include "Bitboard.hpp"
+#include "Move.hpp"
+#include "Psqt.hpp"
+#include "Zobrist.hpp"
+
+extern const char* const StartFen;
+
+// Bitboard board representation: one mask per piece type and per color, a
+// mailbox of 4-bit piece codes for square lookups, the Zobrist keys and the
+// running material and piece-square score with the game phase. The
+// board state fits in two cache lines; moves are played and taken back
+// through makeMove/unmakeMove, which keep a fixed-size stack of undo records
+// after it.
+class Position {
+public:
+    static constexpr int MaxGamePly = 1024;
+
+    // Everything makeMove destroys that cannot be recomputed from the move.
+    struct UndoInfo {
+        Zobrist::Key key;
+        PieceType captured;
+        std::uint8_t castling;
+        std::int8_t epSquare;
+        std::uint16_t halfmoves;
+    };
+
+    enum CastlingRight : std::uint8_t {
+        WhiteKingSide = 1,
+        WhiteQueenSide = 2,
+        BlackKingSide = 4,
+        BlackQueenSide = 8,
+        AllCastling = 15
+    };
+
+    Position();
+    void clear();
+    void setStartPosition();
+
+    // Forsyth-Edwards Notation. setFen leaves the position cleared and
+    // returns false if the string cannot be parsed or describes a position
+    // no game can reach: too many pieces, pawns on the back ranks, the side
+    // not to move in check, castling and en passant rights the board does
+    // not back up, or move counters out of range.
+    bool setFen(const std::string& fen);
+    std::string fen() const;
+
+    Bitboard pieces(Color color, PieceType type) const {
+        return byType[typeIndex(type)] & byColor[colorIndex(color)];
+    }
+    // Pieces of one type of both colors.
+    Bitboard pieces(PieceType type) const {
+        return byType[typeIndex(type)];
+    }
+    Bitboard pieces(Color color) const {
+        return byColor[colorIndex(color)];
+    }
+    Bitboard occupied() const {
+        return byColor[0] | byColor[1];
+    }
+    bool isEmpty(int square) const {
+        return (occupied() & squareBB(square)) == 0;
+    }
+
+    Piece pieceOn(int square) const {
+        return static_cast<Piece>((mailbox[square >> 1] >> ((square & 1) << 2)) & 15);
+    }
+    PieceType pieceTypeOn(int square) const { return typeOf(pieceOn(square)); }
+    // Only meaningful for an occupied square.
+    Color colorOn(int square) const { return colorOf(pieceOn(square)); }
+
+    Color sideToMove() const { return side; }
+    int enPassantSquare() const { return epSquare; }
+    int castlingRights() const { return castling; }
+    int halfmoveClock() const { return halfmoves; }
+    // setFen accepts only boards with one king per side, so every set-up
+    // position has both kings and this is a single bit scan.
+    int kingSquare(Color color) const {
+        return lsb(pieces(color, PieceType::King));
+    }
+
+    // Updated incrementally by every move. The en passant file is only part
+    // of the key when a pawn can actually capture there, so transpositions
+    // after a harmless double push get the same key.
+    Zobrist::Key key() const { return positionKey; }
+    // The key recomputed from scratch; always equals key().
+    Zobrist::Key computeKey() const;
+    // Key of the pawns alone, for the pawn hash table; updated like key().
+    Zobrist::Key pawnKey() const { return pawnHashKey; }
+    // Material plus piece-square bonuses from White's point of view, and
+    // the game phase (Psqt::MaxPhase with every piece on, 0 with pawns and
+    // kings only). Both follow every move like the key.
+    Score psqScore() const { return psq; }
+    int phase() const { return gamePhase; }
+    // The score recomputed from scratch; always equals psqScore().
+    Score computePsqScore() const;
+
+    // True if the position occurred before since the last capture or pawn
+    // move.
+    bool isRepetition() const;
+
+    // Pieces of both colors attacking `square` given the occupancy.
+    Bitboard attackersTo(int square, Bitboard occupied) const;
+    bool isSquareAttacked(int square, Color by) const;
+    bool isSquareAttacked(int square, Color by, Bitboard occupied) const;
+    // Every square attacked by one side given the occupancy; answers many
+    // isSquareAttacked questions with a single pass over its pieces.
+    Bitboard attacksBy(Color by, Bitboard occupied) const;
+    // Enemy pieces giving check to the side to move.
+    Bitboard checkers() const;
+    bool isInCheck(Color color) const;
+    bool isPromotion(int from, int to) const;
+
+    // King destinations of the side to move for castling moves that are
+    // currently legal. `attacked` holds the squares the opponent attacks.
+    Bitboard castlingTargets() const;
+    Bitboard castlingTargets(Bitboard attacked) const;
+
+    // Plays a pseudo-legal move and pushes its undo record. The move must
+    // carry its type (promotion, en passant or castling) as produced by the
+    // move generator.
+    void makeMove(const Move& move);
+    // Takes back the last move played with makeMove.
+    void unmakeMove(const Move& move);
+    // Passes the turn, for null-move pruning; never while in check. It
+    // resets the halfmove clock, so repetitions are not matched across it.
+    void makeNullMove();
+    void unmakeNullMove();
+    int gamePly() const { return undoCount; }
+    // Forgets the undo records from before the last irreversible move,
+    // which isRepetition no longer looks at, so a long game leaves room on
+    // the undo stack for a search. Moves before that cannot be taken back.
+    // At most half the stack is kept, far more than the hundred plies after
+    // which the fifty-move rule ends the game anyway.
+    void trimHistory();
+
+    void putPiece(Color color, PieceType type, int square);
+    void removePiece(Color color, PieceType type, int square);
+
+private:
+    Bitboard byType[6];
+    Bitboard byColor[2];
+    // Two piece codes per byte, the even square in the low nibble.
+    std::uint8_t mailbox[32];
+    Zobrist::Key positionKey;
+    Zobrist::Key pawnHashKey;
+    Score psq;
+    std::uint8_t gamePhase;
+    Color side;
+    std::uint8_t castling;
+    std::int8_t epSquare;
+    // Wide enough that a GUI game, which never ends on the fifty-move rule,
+    // does not wrap it.
+    std::uint16_t halfmoves;
+    std::uint16_t fullmoves;
+    std::uint16_t undoCount;
+    UndoInfo undoStack[MaxGamePly];
+
+    void movePiece(Color color, PieceType type, int from, int to);
+    void setPieceOn(int square, Piece piece) {
+        int shift = (square & 1) << 2;
+        std::uint8_t& cell = mailbox[square >> 1];
+        cell = static_cast<std::uint8_t>((cell & ~(15 << shift)) | (static_cast<int>(piece) << shift));
+    }
+    Zobrist::Key enPassantKey() const;
+};
+
+#endif // POSITION_HPP
@@ -0,0 +1,111 @@
+#include "Psqt.hpp"
+
+namespace {
+    // Endgame material by piece type; the middlegame uses PieceValues.
+    // Rooks and pawns gain in the endgame, the minor pieces lose a little.
+    constexpr int EndgameValues[6] = { 120, 300, 320, 530, 950, 0 };
+
+    // Middlegame piece-square bonuses from White's point of view, a1
+    // first. Black squares are mirrored vertically with `square ^ 56`.
+    constexpr int MiddlegameSquare[6][64] = {
+        { // Pawn
+              0,   0,   0,   0,   0,   0,   0,   0,
+              5,  10,  10, -20, -20,  10,  10,   5,
+              5,  -5, -10,   0,   0, -10,  -5,   5,
+              0,   0,   0,  20,  20,   0,   0,   0,
+              5,   5,  10,  25,  25,  10,   5,   5,
+             10,  10,  20,  30,  30,  20,  10,  10,
+             50,  50,  50,  50,  50,  50,  50,  50,
+              0,   0,   0,   0,   0,   0,   0,   0 },
+        { // Knight
+            -50, -40, -30, -30, -30, -30, -40, -50,
+            -40, -20,   0,   5,   5,   0, -20, -40,
+            -30,   5,  10,  15,  15,  10,   5, -30,
+            -30,   0,  15,  20,  20,  15,   0, -30,
+            -30,   5,  15,  20,  20,  15,   5, -30,
+            -30,   0,  10,  15,  15,  10,   0, -30,
+            -40, -20,   0,   0,   0,   0, -20, -40,
+            -50, -40, -30, -30, -30, -30, -40, -50 },
+        { // Bishop
+            -20, -10, -10, -10, -10, -10, -10, -20,
+            -10,   5,   0,   0,   0,   0,   5, -10,
+            -10,  10,  10,  10,  10,  10,  10, -10,
+            -10,   0,  10,  10,  10,  10,   0, -10,
+            -10,   5,   5,  10,  10,   5,   5, -10,
+            -10,   0,   5,  10,  10,   5,   0, -10,
+            -10,   0,   0,   0,   0,   0,   0, -10,
+            -20, -10, -10, -10, -10, -10, -10, -20 },
+        { // Rook
+              0,   0,   0,   5,   5,   0,   0,   0,
+             -5,   0,   0,   0,   0,   0,   0,  -5,
+             -5,   0,   0,   0,   0,   0,   0,  -5,
+             -5,   0,   0,   0,   0,   0,   0,  -5,
+             -5,   0,   0,   0,   0,   0,   0,  -5,
+             -5,   0,   0,   0,   0,   0,   0,  -5,
+              5,  10,  10,  10,  10,  10,  10,   5,
+              0,   0,   0,   0,   0,   0,   0,   0 },
+        { // Queen
+            -20, -10, -10,  -5,  -5, -10, -10, -20,
+            -10,   0,   5,   0,   0,   0,   0, -10,
+            -10,   5,   5,   5,   5,   5,   0, -10,
+              0,   0,   5,   5,   5,   5,   0,  -5,
+             -5,   0,   5,   5,   5,   5,   0,  -5,
+            -10,   0,   5,   5,   5,   5,   0, -10,
+            -10,   0,   0,   0,   0,   0,   0, -10,
+            -20, -10, -10,  -5,  -5, -10, -10, -20 },
+        { // King
+             20,  30,  10,   0,   0,  10,  30,  20,
+             20,  20,   0,   0,   0,   0,  20,  20,
+            -10, -20, -20, -20, -20, -20, -20, -10,
+            -20, -30, -30, -40, -40, -30, -30, -20,
+            -30, -40, -40, -50, -50, -40, -40, -30,
+            -30, -40, -40, -50, -50, -40, -40, -30,
+            -30, -40, -40, -50, -50, -40, -40, -30,
+            -30, -40, -40, -50, -50, -40, -40, -30 },
+    };
+
+    // In the endgame pawns are worth more the closer they are to promoting
+    // and the king belongs in the centre. The other pieces keep their
+    // middlegame tables.
+    constexpr int EndgamePawnSquare[64] = {
+          0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,
+          5,   5,   5,   5,   5,   5,   5,   5,
+         15,  15,  15,  15,  15,  15,  15,  15,
+         30,  30,  30,  30,  30,  30,  30,  30,
+         55,  55,  55,  55,  55,  55,  55,  55,
+         90,  90,  90,  90,  90,  90,  90,  90,
+          0,   0,   0,   0,   0,   0,   0,   0 };
+
+    constexpr int EndgameKingSquare[64] = {
+        -50, -30, -30, -30, -30, -30, -30, -50,
+        -30, -20, -10, -10, -10, -10, -20, -30,
+        -30, -10,  20,  30,  30,  20, -10, -30,
+        -30, -10,  30,  40,  40,  30, -10, -30,
+        -30, -10,  30,  40,  40,  30, -10, -30,
+        -30, -10,  20,  30,  30,  20, -10, -30,
+        -30, -20, -10, -10, -10, -10, -20, -30,
+        -50, -30, -30, -30, -30, -30, -30, -50 };
+
+    constexpr int endgameSquare(int type, int square) {
+        return type == 0 ? EndgamePawnSquare[square]
+            : type == 5 ? EndgameKingSquare[square]
+            : MiddlegameSquare[type][square];
+    }
+
+    constexpr Psqt::Tables generateTables() {
+        Psqt::Tables result{};
+        for (int type = 0; type < 6; ++type) {
+            for (int square = 0; square < 64; ++square) {
+                Score score = {
+                    static_cast<std::int16_t>(Psqt::PieceValues[type] + MiddlegameSquare[type][square]),
+                    static_cast<std::int16_t>(EndgameValues[type] + endgameSquare(type, square)) };
+                result.pieceSquare[0][type][square] = score;
+                result.pieceSquare[1][type][square ^ 56] = -score;
+            }
+        }
+        return result;
+    }
+}
+
+constinit const Psqt::Tables Psqt::tables = generateTables();
@@ -0,0 +1,67 @@
+#ifndef PSQT_HPP
+#define PSQT_HPP
+
+#include <cstdint>
+#include "Types.hpp"
+
+// An evaluation term with a middlegame and an endgame value, blended by how
+// much material is left. Sixteen bits per half keep it small enough for
+// Position to carry a running total.
+struct Score {
+    std::int16_t mg;
+    std::int16_t eg;
+
+    constexpr Score operator+(Score other) const {
+        return { static_cast<std::int16_t>(mg + other.mg), static_cast<std::int16_t>(eg + other.eg) };
+    }
+    constexpr Score operator-(Score other) const {
+        return { static_cast<std::int16_t>(mg - other.mg), static_cast<std::int16_t>(eg - other.eg) };
+    }
+    constexpr Score operator-() const {
+        return { static_cast<std::int16_t>(-mg), static_cast<std::int16_t>(-eg) };
+    }
+    constexpr Score operator*(int factor) const {
+        return { static_cast<std::int16_t>(mg * factor), static_cast<std::int16_t>(eg * factor) };
+    }
+    Score& operator+=(Score other) { return *this = *this + other; }
+    Score& operator-=(Score other) { return *this = *this - other; }
+};
+
+// Material plus piece-square bonus of every piece on every square, White
+// positive and Black negative, so the sum over the board is the score from
+// White's point of view. Position keeps that sum and the game phase up to
+// date as pieces are put, removed and moved.
+namespace Psqt {
+    // The phase with all minor and major pieces on the board; it counts
+    // down to 0 as they come off.
+    constexpr int MaxPhase = 24;
+    // Centipawn value of each piece type, indexed by PieceType; the king
+    // has none. These are the middlegame material values, and the values
+    // SEE and the search weigh pieces by.
+    constexpr int PieceValues[7] = { 100, 320, 330, 500, 900, 0, 0 };
+    // Phase weight of each piece type.
+    constexpr int PhaseWeights[6] = { 0, 1, 1, 2, 4, 0 };
+
+    struct Tables {
+        Score pieceSquare[2][6][64];
+    };
+
+    // Generated at compile time like the Zobrist keys.
+    extern const Tables tables;
+
+    inline Score piece(Color color, PieceType type, int square) {
+        return tables.pieceSquare[colorIndex(color)][typeIndex(type)][square];
+    }
+
+    // Blends the two halves: the middlegame value at MaxPhase, the
+    // endgame value at 0. Phases above MaxPhase (promotions) count as
+    // MaxPhase.
+    inline int taper(Score score, int phase) {
+        if (phase > MaxPhase) {
+            phase = MaxPhase;
+        }
+        return (score.mg * phase + score.eg * (MaxPhase - phase)) / MaxPhase;
+    }
+}
+
+#endif // PSQT_HPP
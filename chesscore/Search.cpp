@@ -0,0 +1,623 @@
+#include "Search.hpp"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <utility>
+#include "Evaluate.hpp"
+#include "MoveGen.hpp"
+#include "MovePicker.hpp"
+#include "Nnue.hpp"
+
+namespace {
+    // How often the limits are checked, in nodes; must be a power of two.
+    const std::uint64_t LimitCheckInterval = 2048;
+
+    // Time for one move from the game clock: an even share of the time left
+    // until the next control plus most of the increment, keeping a margin
+    // for communication delays.
+    int allocateTime(int timeLeft, int increment, int movesToGo) {
+        const int SafetyMarginMs = 50;
+        int moves = movesToGo > 0 ? std::min(movesToGo, 30) : 30;
+        int budget = timeLeft / moves + increment * 3 / 4;
+        return std::max(1, std::min(budget, timeLeft - SafetyMarginMs));
+    }
+
+    bool isMateScore(int score) {
+        return score >= MateScore - MaxPly || score <= -MateScore + MaxPly;
+    }
+
+    // Mate scores count plies from the root; the table stores them as
+    // distance from the node so they stay valid wherever it is reached.
+    int scoreToTable(int score, int ply) {
+        return score >= MateScore - MaxPly ? score + ply : score <= -MateScore + MaxPly ? score - ply : score;
+    }
+
+    int scoreFromTable(int score, int ply) {
+        return score >= MateScore - MaxPly ? score - ply : score <= -MateScore + MaxPly ? score + ply : score;
+    }
+
+    // Depth skipping pattern of the helper threads, so that at any time they
+    // are spread over the current and the next few iterations.
+    const int SkipSize[] = { 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4 };
+    const int SkipPhase[] = { 0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7 };
+    const int SkipPatterns = sizeof(SkipSize) / sizeof(SkipSize[0]);
+
+    // Pruning margins in centipawns per ply of remaining depth.
+    const int FutilityDepth = 3;
+    const int FutilityMargin = 150;
+    const int ReverseFutilityDepth = 6;
+    const int ReverseFutilityMargin = 90;
+    const int NullMoveDepth = 3;
+    const int LateMoveDepth = 3;
+
+    // Late move reductions in plies, indexed by depth and move number.
+    struct ReductionTable {
+        int plies[MaxPly + 1][64];
+
+        ReductionTable() {
+            for (int depth = 0; depth <= MaxPly; ++depth) {
+                for (int moves = 0; moves < 64; ++moves) {
+                    plies[depth][moves] = (depth && moves)
+                        ? static_cast<int>(0.75 + std::log(depth) * std::log(moves) / 2.25) : 0;
+                }
+            }
+        }
+
+        int operator()(int depth, int moveCount) const {
+            return plies[std::min(depth, MaxPly)][std::min(moveCount, 63)];
+        }
+    };
+    const ReductionTable Reductions;
+
+    int nonPawnMaterial(const Position& position, Color color) {
+        int material = 0;
+        for (PieceType type : { PieceType::Knight, PieceType::Bishop, PieceType::Rook, PieceType::Queen }) {
+            material += Psqt::PieceValues[typeIndex(type)] * popCount(position.pieces(color, type));
+        }
+        return material;
+    }
+}
+
+// Everything one thread needs to search: its own copy of the position, move
+// stacks, network accumulators, pawn hash table and node counter.
+class SearchWorker {
+public:
+    SearchWorker(Search& search, int index);
+
+    void start(const Position& root, const Move& firstMove);
+    int searchRoot(int depth);
+    // Iterative deepening of a helper thread; returns when stopped.
+    void runHelper(int maxDepth);
+
+    std::uint64_t nodeCount() const { return nodes.load(std::memory_order_relaxed); }
+    // Only read once the thread has stopped searching.
+    const PawnTable& pawns() const { return pawnTable; }
+    bool resizePawnTable(std::size_t megabytes) { return pawnTable.resize(megabytes); }
+    const Move& bestMove() const { return rootBest; }
+
+private:
+    Search& search;
+    int index;
+    Position position;
+    // Written by this thread only and read by the main thread for reports.
+    std::atomic<std::uint64_t> nodes;
+    Move rootBest;
+    // Move ordering statistics; every thread learns its own.
+    Move killers[MaxPly + 1][2];
+    MoveHistory history;
+    // The move played at each ply of the current line, for countermoves.
+    Move playedMoves[MaxPly + 1];
+    PawnTable pawnTable;
+    // With a network, the accumulator of the position at each ply of the
+    // current line. A move only records its changes; the accumulator is
+    // brought up to date when the position is evaluated, from the nearest
+    // ply that is.
+    Nnue::Accumulator accumulators[MaxPly + 1];
+    Nnue::DirtyPieces changes[MaxPly + 1];
+    bool accumulatorReady[MaxPly + 1];
+
+    // `allowNull` is false right after a null move and in its verification.
+    int alphaBeta(int depth, int alpha, int beta, int ply, bool allowNull);
+    int quiescence(int alpha, int beta, int ply);
+
+    // Play a move from the position at `ply`; unmake through the position.
+    void makeMove(const Move& move, int ply);
+    void makeNullMove(int ply);
+    // The network's score when one is loaded, the classical one otherwise.
+    int staticEvaluation(int ply);
+
+    Move counterMove(int ply) const;
+    // Rewards the quiet move that caused a cutoff and punishes the quiet
+    // moves searched before it.
+    void updateQuietStats(int ply, int depth, const Move& move, const Move* tried, int triedCount);
+    bool stopped() const { return search.stopped.load(std::memory_order_relaxed); }
+    void countNode();
+};
+
+bool* SearchOptions::find(const std::string& name) {
+    bool* flags[] = { &nullMove, &lateMoveReductions, &futility, &reverseFutility, &pvs };
+    for (std::size_t i = 0; i < std::size(Names); ++i) {
+        if (name == Names[i]) {
+            return flags[i];
+        }
+    }
+    return nullptr;
+}
+
+SearchWorker::SearchWorker(Search& search, int index) : search(search), index(index), nodes(0) {
+}
+
+void SearchWorker::start(const Position& root, const Move& firstMove) {
+    position = root;
+    rootBest = firstMove;
+    nodes.store(0, std::memory_order_relaxed);
+    for (auto& plyKillers : killers) {
+        plyKillers[0] = plyKillers[1] = Move();
+    }
+    history.clear();
+    pawnTable.resetStats();
+    if (search.network) {
+        search.network->refresh(position, accumulators[0]);
+        accumulatorReady[0] = true;
+    }
+}
+
+void SearchWorker::makeMove(const Move& move, int ply) {
+    if (search.network) {
+        changes[ply + 1] = Nnue::changesOf(position, move);
+        accumulatorReady[ply + 1] = false;
+    }
+    position.makeMove(move);
+}
+
+void SearchWorker::makeNullMove(int ply) {
+    if (search.network) {
+        changes[ply + 1] = Nnue::DirtyPieces{};
+        accumulatorReady[ply + 1] = false;
+    }
+    position.makeNullMove();
+}
+
+int SearchWorker::staticEvaluation(int ply) {
+    const Nnue::Network* network = search.network;
+    if (!network) {
+        return evaluate(position, pawnTable);
+    }
+    int ready = ply;
+    while (!accumulatorReady[ready]) {
+        --ready;
+    }
+    for (; ready < ply; ++ready) {
+        network->update(accumulators[ready], changes[ready + 1], accumulators[ready + 1]);
+        accumulatorReady[ready + 1] = true;
+    }
+    return network->evaluate(accumulators[ply], position.sideToMove());
+}
+
+void SearchWorker::countNode() {
+    // A plain increment; no other thread writes the counter.
+    std::uint64_t count = nodes.load(std::memory_order_relaxed) + 1;
+    nodes.store(count, std::memory_order_relaxed);
+    if (index == 0 && (count & (LimitCheckInterval - 1)) == 0) {
+        search.checkLimits();
+    }
+}
+
+Search::Search(TranspositionTable& table)
+    : table(table), network(nullptr), pawnHashMB(PawnTable::DefaultSizeMB), stopped(false), pondering(false) {
+    setThreads(1);
+}
+
+Search::~Search() {
+}
+
+void Search::setThreads(int count) {
+    count = std::max(count, 1);
+    workers.clear();
+    for (int i = 0; i < count; ++i) {
+        workers.push_back(std::make_unique<SearchWorker>(*this, i));
+        if (pawnHashMB != PawnTable::DefaultSizeMB) {
+            workers.back()->resizePawnTable(pawnHashMB);
+        }
+    }
+}
+
+int Search::threads() const {
+    return static_cast<int>(workers.size());
+}
+
+void Search::setOptions(const SearchOptions& searchOptions) {
+    options = searchOptions;
+}
+
+bool Search::setPawnHashSize(std::size_t megabytes) {
+    pawnHashMB = megabytes;
+    bool allocated = true;
+    for (auto& worker : workers) {
+        allocated = worker->resizePawnTable(megabytes) && allocated;
+    }
+    return allocated;
+}
+
+void Search::setNetwork(const Nnue::Network* evaluationNetwork) {
+    network = evaluationNetwork;
+}
+
+void Search::stop() {
+    stopped.store(true, std::memory_order_relaxed);
+}
+
+long long Search::elapsedMs() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+long long Search::clockMs() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - clockStart).count();
+}
+
+std::uint64_t Search::nodesSearched() const {
+    std::uint64_t total = 0;
+    for (const auto& worker : workers) {
+        total += worker->nodeCount();
+    }
+    return total;
+}
+
+void Search::checkLimits() {
+    if (limits.interrupted && limits.interrupted()) {
+        stop();
+        return;
+    }
+    if (pondering) {
+        if (!limits.ponderhit || !limits.ponderhit()) {
+            return;
+        }
+        pondering = false;
+        clockStart = std::chrono::steady_clock::now();
+    }
+    if ((limits.moveTimeMs > 0 && clockMs() >= limits.moveTimeMs) ||
+        (limits.nodes > 0 && nodesSearched() >= limits.nodes)) {
+        stop();
+    }
+}
+
+Move SearchWorker::counterMove(int ply) const {
+    // No countermove for the root or a null move.
+    if (ply == 0 || playedMoves[ply - 1] == Move()) {
+        return Move();
+    }
+    int to = playedMoves[ply - 1].to();
+    return history.counterMoves[static_cast<int>(position.pieceOn(to))][to];
+}
+
+void SearchWorker::updateQuietStats(int ply, int depth, const Move& move, const Move* tried, int triedCount) {
+    if (killers[ply][0] != move) {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = move;
+    }
+    int bonus = std::min(depth * depth, 400);
+    history.update(position.pieceOn(move.from()), move.to(), bonus);
+    for (int i = 0; i < triedCount; ++i) {
+        history.update(position.pieceOn(tried[i].from()), tried[i].to(), -bonus);
+    }
+    if (ply > 0 && playedMoves[ply - 1] != Move()) {
+        int to = playedMoves[ply - 1].to();
+        history.counterMoves[static_cast<int>(position.pieceOn(to))][to] = move;
+    }
+}
+
+int SearchWorker::quiescence(int alpha, int beta, int ply) {
+    countNode();
+    if (stopped()) {
+        return 0;
+    }
+
+    bool inCheck = position.isInCheck(position.sideToMove());
+    if (ply >= MaxPly) {
+        return inCheck ? 0 : staticEvaluation(ply);
+    }
+
+    // Standing pat is not an option in check, so every evasion is searched.
+    if (!inCheck) {
+        int standPat = staticEvaluation(ply);
+        if (standPat >= beta) {
+            return standPat;
+        }
+        if (standPat > alpha) {
+            alpha = standPat;
+        }
+    }
+
+    // In check every evasion is searched; otherwise only captures and queen
+    // promotions, minus the captures that lose material on the exchange.
+    MovePicker picker(position, history);
+    bool anyMove = false;
+    for (Move move; (move = picker.next()) != Move();) {
+        anyMove = true;
+        makeMove(move, ply);
+        int score = -quiescence(-beta, -alpha, ply + 1);
+        position.unmakeMove(move);
+
+        if (score > alpha) {
+            if (score >= beta) {
+                return score;
+            }
+            alpha = score;
+        }
+    }
+    if (inCheck && !anyMove) {
+        return -MateScore + ply;
+    }
+    return alpha;
+}
+
+int SearchWorker::alphaBeta(int depth, int alpha, int beta, int ply, bool allowNull) {
+    if (depth <= 0) {
+        return quiescence(alpha, beta, ply);
+    }
+    countNode();
+    if (stopped()) {
+        return 0;
+    }
+    if (position.isRepetition()) {
+        return 0;
+    }
+    if (ply >= MaxPly) {
+        return staticEvaluation(ply);
+    }
+
+    TranspositionTable::Data entry;
+    Move hashMove;
+    if (search.table.probe(position.key(), entry)) {
+        hashMove = entry.move;
+        int score = scoreFromTable(entry.score, ply);
+        if (entry.depth >= depth &&
+            (entry.bound == TranspositionTable::BoundExact ||
+             (entry.bound == TranspositionTable::BoundLower && score >= beta) ||
+             (entry.bound == TranspositionTable::BoundUpper && score <= alpha))) {
+            return score;
+        }
+    }
+
+    // The fifty-move rule draws unless the move that reached it mated.
+    if (position.halfmoveClock() >= 100) {
+        MoveList moves;
+        generateLegalMoves(position, moves);
+        return (moves.empty() && position.checkers()) ? -MateScore + ply : 0;
+    }
+
+    const SearchOptions& options = search.options;
+    bool pvNode = beta - alpha > 1;
+    bool inCheck = position.checkers() != 0;
+    int staticEval = inCheck ? -InfiniteScore : staticEvaluation(ply);
+
+    // Reverse futility: a quiet position this far above beta will not fall
+    // below it within a few plies.
+    if (options.reverseFutility && !pvNode && !inCheck && depth <= ReverseFutilityDepth && !isMateScore(beta) &&
+        staticEval - ReverseFutilityMargin * depth >= beta) {
+        return staticEval;
+    }
+
+    // Null move: if passing still fails high, a real move will too. Without
+    // pieces zugzwang is common, so the null move is skipped; with little
+    // material a reduced search without null moves confirms the cutoff.
+    Color us = position.sideToMove();
+    if (options.nullMove && allowNull && !pvNode && !inCheck && depth >= NullMoveDepth && staticEval >= beta &&
+        nonPawnMaterial(position, us) > 0) {
+        int reduction = 3 + depth / 6;
+        playedMoves[ply] = Move();
+        makeNullMove(ply);
+        int score = -alphaBeta(depth - 1 - reduction, -beta, -beta + 1, ply + 1, false);
+        position.unmakeNullMove();
+        if (stopped()) {
+            return 0;
+        }
+        if (score >= beta) {
+            score = isMateScore(score) ? beta : score;
+            if (nonPawnMaterial(position, us) > Psqt::PieceValues[typeIndex(PieceType::Rook)] ||
+                alphaBeta(depth - reduction, beta - 1, beta, ply, false) >= beta) {
+                return score;
+            }
+        }
+    }
+
+    bool canPrune = options.futility && !pvNode && !inCheck && depth <= FutilityDepth && !isMateScore(alpha) &&
+        staticEval + FutilityMargin * depth <= alpha;
+
+    int originalAlpha = alpha;
+    int bestScore = -InfiniteScore;
+    Move bestMove;
+    Move quietsTried[64];
+    int quietCount = 0;
+    int moveCount = 0;
+    MovePicker picker(position, hashMove, killers[ply], counterMove(ply), history);
+    for (Move move; (move = picker.next()) != Move();) {
+        bool quiet = isQuietMove(position, move);
+        ++moveCount;
+        playedMoves[ply] = move;
+        makeMove(move, ply);
+        bool givesCheck = position.checkers() != 0;
+
+        // Futility: this quiet move cannot bring the score up to alpha.
+        if (canPrune && quiet && !givesCheck && bestScore > -InfiniteScore) {
+            position.unmakeMove(move);
+            continue;
+        }
+
+        int newDepth = depth - 1;
+        int score = 0;
+        bool fullDepth = true;
+        if (options.lateMoveReductions && depth >= LateMoveDepth && moveCount > 1 && quiet && !inCheck &&
+            !givesCheck) {
+            int reduction = std::min(Reductions(depth, moveCount) - (pvNode ? 1 : 0), newDepth - 1);
+            if (reduction > 0) {
+                int window = options.pvs ? alpha + 1 : beta;
+                score = -alphaBeta(newDepth - reduction, -window, -alpha, ply + 1, true);
+                fullDepth = score > alpha;
+            }
+        }
+        if (fullDepth) {
+            if (options.pvs && moveCount > 1) {
+                score = -alphaBeta(newDepth, -alpha - 1, -alpha, ply + 1, true);
+                if (score > alpha && score < beta) {
+                    score = -alphaBeta(newDepth, -beta, -alpha, ply + 1, true);
+                }
+            }
+            else {
+                score = -alphaBeta(newDepth, -beta, -alpha, ply + 1, true);
+            }
+        }
+        position.unmakeMove(move);
+
+        if (score > bestScore) {
+            bestScore = score;
+            if (score > alpha) {
+                bestMove = move;
+                if (score >= beta) {
+                    if (quiet) {
+                        updateQuietStats(ply, depth, move, quietsTried, quietCount);
+                    }
+                    break;
+                }
+                alpha = score;
+            }
+        }
+        if (quiet && quietCount < 64) {
+            quietsTried[quietCount++] = move;
+        }
+    }
+    if (moveCount == 0) {
+        return inCheck ? -MateScore + ply : 0;
+    }
+
+    if (!stopped()) {
+        TranspositionTable::Bound bound = bestScore >= beta ? TranspositionTable::BoundLower
+            : bestScore > originalAlpha ? TranspositionTable::BoundExact : TranspositionTable::BoundUpper;
+        search.table.store(position.key(), depth, scoreToTable(bestScore, ply), bound, bestMove);
+    }
+    return bestScore;
+}
+
+int SearchWorker::searchRoot(int depth) {
+    int alpha = -InfiniteScore;
+    Move best = rootBest;
+    bool first = true;
+    MovePicker picker(position, rootBest, killers[0], Move(), history);
+    for (Move move; (move = picker.next()) != Move();) {
+        playedMoves[0] = move;
+        makeMove(move, 0);
+        int score;
+        if (search.options.pvs && !first) {
+            score = -alphaBeta(depth - 1, -alpha - 1, -alpha, 1, true);
+            if (score > alpha && !stopped()) {
+                score = -alphaBeta(depth - 1, -InfiniteScore, -alpha, 1, true);
+            }
+        }
+        else {
+            score = -alphaBeta(depth - 1, -InfiniteScore, -alpha, 1, true);
+        }
+        position.unmakeMove(move);
+        first = false;
+
+        if (stopped()) {
+            break;
+        }
+        if (score > alpha) {
+            alpha = score;
+            best = move;
+        }
+    }
+    rootBest = best;
+    if (!stopped()) {
+        search.table.store(position.key(), depth, scoreToTable(alpha, 0), TranspositionTable::BoundExact, best);
+    }
+    return alpha;
+}
+
+void SearchWorker::runHelper(int maxDepth) {
+    int pattern = (index - 1) % SkipPatterns;
+    for (int depth = 1; depth <= maxDepth && !stopped(); ++depth) {
+        if (((depth + SkipPhase[pattern]) / SkipSize[pattern]) % 2) {
+            continue;
+        }
+        searchRoot(depth);
+    }
+}
+
+SearchInfo Search::think(const Position& position, const SearchLimits& searchLimits, const Reporter& report) {
+    limits = searchLimits;
+    startTime = std::chrono::steady_clock::now();
+    clockStart = startTime;
+    stopped.store(false, std::memory_order_relaxed);
+    pondering = limits.ponder;
+    table.newSearch();
+
+    int us = colorIndex(position.sideToMove());
+    if (limits.timeLeftMs[us] > 0) {
+        int budget = allocateTime(limits.timeLeftMs[us], limits.incrementMs[us], limits.movesToGo);
+        limits.moveTimeMs = limits.moveTimeMs > 0 ? std::min(limits.moveTimeMs, budget) : budget;
+    }
+
+    SearchInfo result;
+    MoveList rootMoves;
+    generateLegalMoves(position, rootMoves);
+    if (rootMoves.empty()) {
+        return result;
+    }
+    // Something to play even if the first iteration is cut short.
+    result.bestMove = rootMoves[0];
+    result.hasMove = true;
+    for (auto& worker : workers) {
+        worker->start(position, rootMoves[0]);
+    }
+
+    int maxDepth = (limits.depth > 0 && limits.depth < MaxPly) ? limits.depth : MaxPly;
+    std::vector<std::thread> helpers;
+    for (std::size_t i = 1; i < workers.size(); ++i) {
+        // Helpers may run past the depth limit; they stop with the main thread.
+        helpers.emplace_back(&SearchWorker::runHelper, workers[i].get(), MaxPly);
+    }
+
+    SearchWorker& main = *workers[0];
+    for (int depth = 1; depth <= maxDepth; ++depth) {
+        checkLimits();
+        int score = main.searchRoot(depth);
+        if (stopped.load(std::memory_order_relaxed)) {
+            break;
+        }
+
+        result.depth = depth;
+        result.score = score;
+        result.bestMove = main.bestMove();
+        result.nodes = nodesSearched();
+        result.timeMs = elapsedMs();
+        result.nps = result.timeMs > 0 ? result.nodes * 1000 / result.timeMs : result.nodes * 1000;
+        result.hashfull = table.hashfull();
+        if (report) {
+            report(result);
+        }
+
+        // A single legal move or a forced mate will not change with depth,
+        // and the next iteration usually costs more than all previous ones.
+        if (rootMoves.size() == 1 || isMateScore(score)) {
+            break;
+        }
+        if (!pondering && limits.moveTimeMs > 0 && clockMs() * 2 >= limits.moveTimeMs) {
+            break;
+        }
+    }
+
+    stop();
+    for (std::thread& helper : helpers) {
+        helper.join();
+    }
+    result.nodes = nodesSearched();
+    result.threadNodes.clear();
+    result.pawnHashProbes = result.pawnHashHits = 0;
+    for (const auto& worker : workers) {
+        result.threadNodes.push_back(worker->nodeCount());
+        result.pawnHashProbes += worker->pawns().probes();
+        result.pawnHashHits += worker->pawns().hits();
+    }
+    return result;
+}
@@ -0,0 +1,150 @@
+#ifndef SEARCH_HPP
+#define SEARCH_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Move.hpp"
+#include "Position.hpp"
+#include "TranspositionTable.hpp"
+
+constexpr int MaxPly = 64;
+constexpr int MateScore = 32000;
+constexpr int InfiniteScore = 32001;
+
+struct SearchLimits {
+    int depth = MaxPly;           // deepest iteration to start
+    int moveTimeMs = 0;           // wall-clock budget, 0 for none
+    std::uint64_t nodes = 0;      // node budget over all threads, 0 for none
+    // Game clock, indexed by colorIndex; the time for this move is taken
+    // from the side to move's remaining time when it is set.
+    int timeLeftMs[2] = { 0, 0 };
+    int incrementMs[2] = { 0, 0 };
+    int movesToGo = 0;            // moves until the next time control, 0 for sudden death
+    // Searching on the opponent's time: no time or node limit applies until
+    // `ponderhit` returns true, and the clock starts at that moment.
+    bool ponder = false;
+    std::function<bool()> ponderhit;
+    // Polled along with the clock; returning true ends the search as if
+    // stop() had been called. Lets a caller abort without racing think().
+    std::function<bool()> interrupted;
+};
+
+// Selective search techniques, each of which can be switched off to measure
+// what it is worth. All are on by default.
+struct SearchOptions {
+    // Let the opponent move twice; a score still above beta cuts the node.
+    // Verified by a reduced search where zugzwang is likely.
+    bool nullMove = true;
+    // Search late quiet moves less deep, by log(depth) * log(move number).
+    bool lateMoveReductions = true;
+    // Skip quiet moves near the leaves that cannot lift the static
+    // evaluation to alpha.
+    bool futility = true;
+    // Cut nodes whose static evaluation clears beta by a depth-scaled
+    // margin.
+    bool reverseFutility = true;
+    // Principal variation search: zero-window searches for every move after
+    // the first, re-searched only when one beats alpha.
+    bool pvs = true;
+
+    // The switches by their UCI option names, also used by the bench.
+    static constexpr const char* Names[] = { "NullMove", "LateMoveReductions", "Futility", "ReverseFutility",
+                                             "PVS" };
+    // The switch with the given name, or nullptr.
+    bool* find(const std::string& name);
+};
+
+// Result of one completed iteration.
+struct SearchInfo {
+    int depth = 0;
+    int score = 0;
+    std::uint64_t nodes = 0;
+    long long timeMs = 0;
+    std::uint64_t nps = 0;
+    Move bestMove;
+    bool hasMove = false;
+    // Permill of the transposition table written by this search.
+    int hashfull = 0;
+    // Nodes searched by each thread, main thread first.
+    std::vector<std::uint64_t> threadNodes;
+    // Pawn hash table lookups and hits over all threads in this search.
+    // Like threadNodes, only set in the result think() returns.
+    std::uint64_t pawnHashProbes = 0;
+    std::uint64_t pawnHashHits = 0;
+};
+
+class SearchWorker;
+
+namespace Nnue {
+    class Network;
+}
+
+// Negamax principal variation search with iterative deepening, selective
+// pruning (see SearchOptions) and a capture-only quiescence search. Results
+// are shared through a transposition table. Moves come from
+// a staged MovePicker: table move (at the root the best move of the previous
+// iteration) first, then winning captures by MVV-LVA, killer moves and the
+// countermove, quiet moves by history, and losing captures last.
+//
+// With more than one thread the search is Lazy SMP: helper threads run
+// their own iterative deepening on the same root with staggered depths and
+// share nothing but the transposition table and the stop flag. The main
+// thread alone watches the clock and reports iterations.
+class Search {
+public:
+    using Reporter = std::function<void(const SearchInfo&)>;
+
+    explicit Search(TranspositionTable& table);
+    ~Search();
+
+    // Number of threads used by the next think(), at least one.
+    void setThreads(int count);
+    int threads() const;
+    // Takes effect with the next think().
+    void setOptions(const SearchOptions& options);
+    // Size of the pawn hash table of each thread; clears them all.
+    bool setPawnHashSize(std::size_t megabytes);
+    // Evaluates with `network` from the next think() on, or with the
+    // classical evaluation when it is null. The network must outlive its
+    // use here.
+    void setNetwork(const Nnue::Network* network);
+
+    // Searches `position` until the depth or time limit runs out and returns
+    // the last completed iteration. `report` is called after every iteration.
+    SearchInfo think(const Position& position, const SearchLimits& limits, const Reporter& report = Reporter());
+
+    // Makes a running think() return as soon as possible. Safe to call from
+    // another thread.
+    void stop();
+
+private:
+    friend class SearchWorker;
+
+    TranspositionTable& table;
+    SearchLimits limits;
+    SearchOptions options;
+    const Nnue::Network* network;
+    std::size_t pawnHashMB;
+    // When go arrived, for reported time and speed.
+    std::chrono::steady_clock::time_point startTime;
+    // When our clock started: go, or the ponderhit of a pondering search.
+    // The time limits count from here.
+    std::chrono::steady_clock::time_point clockStart;
+    std::atomic<bool> stopped;
+    // Main search thread only.
+    bool pondering;
+    std::vector<std::unique_ptr<SearchWorker>> workers;
+
+    void checkLimits();
+    std::uint64_t nodesSearched() const;
+    long long elapsedMs() const;
+    long long clockMs() const;
+};
+
+#endif // SEARCH_HPP
@@ -0,0 +1,98 @@
+#include "See.hpp"
+#include <algorithm>
+
+namespace {
+    // Exchanges end at the king, so it only needs to outweigh everything
+    // else; the swap list never subtracts it from anything real.
+    constexpr int SeeValues[6] = { Psqt::PieceValues[0], Psqt::PieceValues[1], Psqt::PieceValues[2],
+                                   Psqt::PieceValues[3], Psqt::PieceValues[4], 20000 };
+
+    // The least valuable of `attackers`, removed from `occupied`.
+    PieceType takeLeastValuable(const Position& position, Bitboard attackers, Bitboard& occupied) {
+        for (int t = 0; t < 6; ++t) {
+            PieceType type = static_cast<PieceType>(t);
+            Bitboard bb = attackers & position.pieces(type);
+            if (bb) {
+                occupied ^= bb & (0 - bb);
+                return type;
+            }
+        }
+        return PieceType::None;
+    }
+}
+
+int see(const Position& position, const Move& move) {
+    using namespace Bitboards;
+    if (move.type() == Move::Castling) {
+        return 0;
+    }
+
+    int from = move.from();
+    int to = move.to();
+    Bitboard occupied = position.occupied() ^ squareBB(from);
+    PieceType attacker = position.pieceTypeOn(from);
+
+    // gain[d] is what the side making capture d has won if the exchange
+    // stops right after it.
+    int gain[32];
+    gain[0] = 0;
+    if (move.type() == Move::EnPassant) {
+        gain[0] = SeeValues[typeIndex(PieceType::Pawn)];
+        occupied ^= squareBB(to - ((position.sideToMove() == Color::White) ? 8 : -8));
+    }
+    else if (!position.isEmpty(to)) {
+        gain[0] = SeeValues[typeIndex(position.pieceTypeOn(to))];
+    }
+    if (move.type() == Move::Promotion) {
+        attacker = move.promotion();
+        gain[0] += SeeValues[typeIndex(attacker)] - SeeValues[typeIndex(PieceType::Pawn)];
+    }
+
+    Bitboard bishops = position.pieces(PieceType::Bishop) | position.pieces(PieceType::Queen);
+    Bitboard rooks = position.pieces(PieceType::Rook) | position.pieces(PieceType::Queen);
+    Bitboard attackers = position.attackersTo(to, occupied) & occupied;
+    Color side = position.sideToMove();
+    int depth = 0;
+    while (depth < 31) {
+        side = opposite(side);
+        Bitboard ours = attackers & position.pieces(side);
+        if (!ours) {
+            break;
+        }
+        // Taking with the king is only legal when nothing can retake.
+        if ((ours & position.pieces(PieceType::King)) == ours && (attackers & position.pieces(opposite(side)))) {
+            break;
+        }
+        // When neither stopping nor recapturing is good for this side, the
+        // sign of the result is settled; stop instead of recapturing.
+        int next = SeeValues[typeIndex(attacker)] - gain[depth];
+        if (std::max(-gain[depth], next) < 0) {
+            break;
+        }
+        gain[++depth] = next;
+
+        attacker = takeLeastValuable(position, ours, occupied);
+        if (attacker == PieceType::Pawn || attacker == PieceType::Bishop || attacker == PieceType::Queen) {
+            attackers |= bishopAttacks(to, occupied) & bishops;
+        }
+        if (attacker == PieceType::Rook || attacker == PieceType::Queen) {
+            attackers |= rookAttacks(to, occupied) & rooks;
+        }
+        attackers &= occupied;
+    }
+
+    // Back up the list: each side either stops or takes the better line.
+    for (; depth > 0; --depth) {
+        gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+    }
+    return gain[0];
+}
+
+bool losesExchange(const Position& position, const Move& move) {
+    PieceType victim = move.type() == Move::EnPassant ? PieceType::Pawn : position.pieceTypeOn(move.to());
+    if (move.type() != Move::Promotion && victim != PieceType::None &&
+        SeeValues[typeIndex(position.pieceTypeOn(move.from()))] <= SeeValues[typeIndex(victim)]) {
+        return false;
+    }
+    return see(position, move) < 0;
+}
@@ -0,0 +1,20 @@
+#ifndef SEE_HPP
+#define SEE_HPP
+
+#include "Move.hpp"
+#include "Position.hpp"
+
+// Static exchange evaluation: the material the side to move wins or loses,
+// in centipawns, if both sides keep capturing on the move's destination
+// with their least valuable attacker and either may stop when it pays.
+// Sliders behind earlier attackers join as the square clears; pins are
+// ignored. Lines that can no longer change the sign of the result are cut
+// short, so the sign is exact even where the magnitude is not. A quiet move
+// scores whatever it loses when it is taken.
+int see(const Position& position, const Move& move);
+
+// True when see() of a capture is negative. Skips the exchange when the
+// victim is worth at least as much as the capturing piece.
+bool losesExchange(const Position& position, const Move& move);
+
+#endif // SEE_HPP
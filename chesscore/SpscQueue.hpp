@@ -0,0 +1,53 @@
+#ifndef SPSCQUEUE_HPP
+#define SPSCQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. push and pop never block; they fail when the queue is full or
+// empty. Capacity must be a power of two.
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    // Producer only.
+    bool push(T value) {
+        std::size_t back = tail.load(std::memory_order_relaxed);
+        if (back - head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots[back & (Capacity - 1)] = std::move(value);
+        tail.store(back + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only.
+    bool pop(T& value) {
+        std::size_t front = head.load(std::memory_order_relaxed);
+        if (front == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = std::move(slots[front & (Capacity - 1)]);
+        head.store(front + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Either thread; only a snapshot while the other side is active.
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+private:
+    T slots[Capacity];
+    // Producer and consumer indices on separate cache lines so the two
+    // threads do not keep stealing one line from each other.
+    alignas(64) std::atomic<std::size_t> head;
+    alignas(64) std::atomic<std::size_t> tail;
+};
+
+#endif // SPSCQUEUE_HPP
@@ -0,0 +1,169 @@
+#include "TranspositionTable.hpp"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Entry data layout:
+    //   bits  0-15  move
+    //   bits 16-31  score
+    //   bits 32-39  depth
+    //   bits 40-41  bound
+    //   bits 42-47  generation
+    constexpr int GenerationBits = 6;
+    constexpr std::uint8_t GenerationMask = (1 << GenerationBits) - 1;
+
+    std::uint64_t load(const std::uint64_t& word) {
+        return std::atomic_ref<std::uint64_t>(const_cast<std::uint64_t&>(word)).load(std::memory_order_relaxed);
+    }
+
+    void save(std::uint64_t& word, std::uint64_t value) {
+        std::atomic_ref<std::uint64_t>(word).store(value, std::memory_order_relaxed);
+    }
+
+    Move unpackMove(std::uint64_t data) {
+        return Move::fromRaw(static_cast<std::uint16_t>(data));
+    }
+
+    std::uint64_t pack(const Move& move, int score, int depth, TranspositionTable::Bound bound, std::uint8_t generation) {
+        return move.raw()
+            | (static_cast<std::uint64_t>(static_cast<std::uint16_t>(score)) << 16)
+            | (static_cast<std::uint64_t>(static_cast<std::uint8_t>(depth)) << 32)
+            | (static_cast<std::uint64_t>(bound) << 40)
+            | (static_cast<std::uint64_t>(generation) << 42);
+    }
+
+    int scoreOf(std::uint64_t data) { return static_cast<std::int16_t>(data >> 16); }
+    int depthOf(std::uint64_t data) { return static_cast<std::int8_t>(data >> 32); }
+    TranspositionTable::Bound boundOf(std::uint64_t data) { return static_cast<TranspositionTable::Bound>((data >> 40) & 3); }
+    std::uint8_t generationOf(std::uint64_t data) { return (data >> 42) & GenerationMask; }
+}
+
+TranspositionTable::TranspositionTable() : buckets(nullptr), bucketCount(0), generation(0) {
+    resize(DefaultSizeMB);
+}
+
+TranspositionTable::~TranspositionTable() {
+    ::operator delete(buckets, std::align_val_t(alignof(Bucket)));
+}
+
+bool TranspositionTable::resize(std::size_t megabytes) {
+    std::size_t wanted = std::max<std::size_t>(megabytes, 1) * 1024 * 1024 / sizeof(Bucket);
+    std::size_t count = 1;
+    while (count * 2 <= wanted) {
+        count *= 2;
+    }
+
+    void* memory = ::operator new(count * sizeof(Bucket), std::align_val_t(alignof(Bucket)), std::nothrow);
+    if (!memory) {
+        std::cerr << "Failed to allocate a " << megabytes << " MB transposition table.\n";
+        return false;
+    }
+    ::operator delete(buckets, std::align_val_t(alignof(Bucket)));
+    buckets = static_cast<Bucket*>(memory);
+    bucketCount = count;
+    clear();
+    return true;
+}
+
+std::size_t TranspositionTable::sizeMB() const {
+    return bucketCount * sizeof(Bucket) / (1024 * 1024);
+}
+
+void TranspositionTable::clear() {
+    unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t slice = (bucketCount + threadCount - 1) / threadCount;
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < threadCount; ++i) {
+        std::size_t begin = std::min(bucketCount, i * slice);
+        std::size_t end = std::min(bucketCount, begin + slice);
+        if (begin == end) {
+            break;
+        }
+        threads.emplace_back([this, begin, end] {
+            std::memset(static_cast<void*>(buckets + begin), 0, (end - begin) * sizeof(Bucket));
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    generation = 0;
+}
+
+void TranspositionTable::newSearch() {
+    generation = (generation + 1) & GenerationMask;
+}
+
+bool TranspositionTable::probe(Zobrist::Key key, Data& result) const {
+    const Bucket& bucket = bucketFor(key);
+    for (const Entry& entry : bucket.entries) {
+        std::uint64_t data = load(entry.data);
+        if ((load(entry.keyXorData) ^ data) != key || boundOf(data) == BoundNone) {
+            continue;
+        }
+        result.move = unpackMove(data);
+        result.score = scoreOf(data);
+        result.depth = depthOf(data);
+        result.bound = boundOf(data);
+        return true;
+    }
+    return false;
+}
+
+void TranspositionTable::store(Zobrist::Key key, int depth, int score, Bound bound, const Move& move) {
+    Bucket& bucket = bucketFor(key);
+    Entry* target = nullptr;
+    std::uint64_t previous = 0;
+
+    std::uint64_t first = load(bucket.entries[0].data);
+    bool firstMatches = (load(bucket.entries[0].keyXorData) ^ first) == key;
+    if (boundOf(first) == BoundNone || generationOf(first) != generation ||
+        depth >= depthOf(first) || (firstMatches && bound == BoundExact)) {
+        target = &bucket.entries[0];
+        previous = firstMatches ? first : 0;
+    }
+    else {
+        // The slot already holding this position, otherwise the shallowest
+        // entry with those from older searches going first.
+        int lowest = INT_MAX;
+        for (int i = 1; i < 4; ++i) {
+            Entry& entry = bucket.entries[i];
+            std::uint64_t data = load(entry.data);
+            if ((load(entry.keyXorData) ^ data) == key) {
+                target = &entry;
+                previous = data;
+                break;
+            }
+            int value = (boundOf(data) == BoundNone) ? INT_MIN
+                : depthOf(data) + (generationOf(data) == generation ? 256 : 0);
+            if (value < lowest) {
+                lowest = value;
+                target = &entry;
+            }
+        }
+    }
+
+    // Keep the best move of an earlier visit if this one did not find any.
+    Move best = (move == Move() && previous) ? unpackMove(previous) : move;
+    std::uint64_t data = pack(best, score, depth, bound, generation);
+    save(target->data, data);
+    save(target->keyXorData, key ^ data);
+}
+
+int TranspositionTable::hashfull() const {
+    std::size_t samples = std::min<std::size_t>(bucketCount, 250);
+    int used = 0;
+    for (std::size_t i = 0; i < samples; ++i) {
+        for (const Entry& entry : buckets[i].entries) {
+            std::uint64_t data = load(entry.data);
+            used += boundOf(data) != BoundNone && generationOf(data) == generation;
+        }
+    }
+    return samples ? static_cast<int>(used * 1000 / (samples * 4)) : 0;
+}
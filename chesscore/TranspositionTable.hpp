@@ -0,0 +1,81 @@
+#ifndef TRANSPOSITIONTABLE_HPP
+#define TRANSPOSITIONTABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "Move.hpp"
+#include "Zobrist.hpp"
+
+// Search results keyed by Zobrist key, shared by every search thread
+// without locks. Each 16-byte entry stores its key XORed with its data; a
+// reader that sees a torn entry from a concurrent write gets a key mismatch
+// and treats it as a miss.
+//
+// Four entries make one 64-byte bucket, so a probe touches one cache line.
+// The first entry of a bucket is depth-preferred: it only gives way to a
+// deeper search or to an entry from an older search. The other three are
+// always-replace slots for everything else.
+class TranspositionTable {
+public:
+    static constexpr std::size_t DefaultSizeMB = 16;
+
+    enum Bound : std::uint8_t {
+        BoundNone,
+        BoundUpper,
+        BoundLower,
+        BoundExact
+    };
+
+    struct Data {
+        Move move;
+        int score;
+        int depth;
+        Bound bound;
+    };
+
+    TranspositionTable();
+    ~TranspositionTable();
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    // Reallocates to the largest power-of-two number of buckets that fits in
+    // `megabytes` and clears it. Keeps the old table if allocation fails.
+    bool resize(std::size_t megabytes);
+    std::size_t sizeMB() const;
+
+    // Zeroes the table from several threads at once, which also commits the
+    // pages of a fresh allocation before the first search.
+    void clear();
+
+    // Called once per search so entries from earlier searches can be told
+    // apart and replaced first.
+    void newSearch();
+
+    // Mate scores must be made relative to the node before storing; the
+    // table keeps scores as given.
+    bool probe(Zobrist::Key key, Data& data) const;
+    void store(Zobrist::Key key, int depth, int score, Bound bound, const Move& move);
+
+    // Permill of sampled entries written by the current search.
+    int hashfull() const;
+
+private:
+    struct Entry {
+        std::uint64_t keyXorData;
+        std::uint64_t data;
+    };
+
+    struct alignas(64) Bucket {
+        Entry entries[4];
+    };
+
+    Bucket* buckets;
+    std::size_t bucketCount;
+    std::uint8_t generation;
+
+    Bucket& bucketFor(Zobrist::Key key) const {
+        return buckets[key & (bucketCount - 1)];
+    }
+};
+
+#endif // TRANSPOSITIONTABLE_HPP
@@ -0,0 +1,40 @@
+#ifndef TYPES_HPP
+#define TYPES_HPP
+
+#include <cstdint>
+
+enum class Color : std::uint8_t { White, Black };
+
+enum class PieceType : std::uint8_t { Pawn, Knight, Bishop, Rook, Queen, King, None };
+
+// A piece in four bits: the type in bits 0-2 and the color in bit 3. An
+// empty square holds NoPiece, whose type bits read as PieceType::None.
+enum class Piece : std::uint8_t { NoPiece = 6 };
+
+constexpr int NoSquare = -1;
+
+constexpr Color opposite(Color color) {
+    return color == Color::White ? Color::Black : Color::White;
+}
+
+constexpr int colorIndex(Color color) {
+    return static_cast<int>(color);
+}
+
+constexpr int typeIndex(PieceType type) {
+    return static_cast<int>(type);
+}
+
+constexpr Piece makePiece(Color color, PieceType type) {
+    return static_cast<Piece>((colorIndex(color) << 3) | typeIndex(type));
+}
+
+constexpr PieceType typeOf(Piece piece) {
+    return static_cast<PieceType>(static_cast<int>(piece) & 7);
+}
+
+constexpr Color colorOf(Piece piece) {
+    return static_cast<Color>(static_cast<int>(piece) >> 3);
+}
+
+#endif // TYPES_HPP
@@ -0,0 +1,34 @@
+#include "Zobrist.hpp"
+
+namespace {
+    // splitmix64: every output of a counter-based generator is independent,
+    // which is all the keys need.
+    constexpr std::uint64_t splitMix(std::uint64_t& state) {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    constexpr Zobrist::Keys generateKeys() {
+        Zobrist::Keys result{};
+        std::uint64_t state = 0x1070372ULL;
+        for (auto& colorKeys : result.pieceSquare) {
+            for (auto& typeKeys : colorKeys) {
+                for (auto& key : typeKeys) {
+                    key = splitMix(state);
+                }
+            }
+        }
+        for (auto& key : result.castling) {
+            key = splitMix(state);
+        }
+        for (auto& key : result.enPassantFile) {
+            key = splitMix(state);
+        }
+        result.blackToMove = splitMix(state);
+        return result;
+    }
+}
+
+constinit const Zobrist::Keys Zobrist::keys = generateKeys();
@@ -0,0 +1,29 @@
+#ifndef ZOBRIST_HPP
+#define ZOBRIST_HPP
+
+#include <cstdint>
+#include "Types.hpp"
+
+// 64-bit position keys. A key is the XOR of one random number per piece on
+// its square, plus numbers for the side to move, the castling rights and
+// the en passant file, so a move updates it with a handful of XORs.
+namespace Zobrist {
+    using Key = std::uint64_t;
+
+    struct Keys {
+        Key pieceSquare[2][6][64];
+        Key castling[16];
+        Key enPassantFile[8];
+        Key blackToMove;
+    };
+
+    // Generated at compile time, so keys are the same in every build and
+    // need no initialisation call.
+    extern const Keys keys;
+
+    inline Key piece(Color color, PieceType type, int square) {
+        return keys.pieceSquare[colorIndex(color)][typeIndex(type)][square];
+    }
+}
+
+#endif // ZOBRIST_HPP